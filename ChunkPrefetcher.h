@@ -0,0 +1,152 @@
+#ifndef CHUNKPREFETCHER_H
+#define CHUNKPREFETCHER_H
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "TerrainCache.h"
+
+// Generates terrain chunks ahead of the camera on worker threads so the
+// render thread finds them cached by the time they scroll into view
+class ChunkPrefetcher
+{
+public:
+    // how far ahead of the camera to look, in seconds of travel at the current speed
+    static constexpr float LookaheadSeconds = 3.0f;
+
+    ChunkPrefetcher(TerrainCache &cache, unsigned threadCount)
+        : mCache(cache), mStop(false)
+    {
+        for (unsigned i = 0; i < threadCount; ++i)
+            mWorkers.emplace_back(&ChunkPrefetcher::workerLoop, this);
+    }
+
+    ~ChunkPrefetcher()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+            mQueue.clear();
+        }
+        mWake.notify_all();
+        for (auto &worker : mWorkers)
+            worker.join();
+    }
+
+    ChunkPrefetcher(const ChunkPrefetcher &) = delete;
+    ChunkPrefetcher &operator=(const ChunkPrefetcher &) = delete;
+
+    // Replans the queue from the camera position, this frame's movement (dx, dy)
+    // and the current movement speed in cells per second
+    void update(float cx, float cy, float dx, float dy, float speed, int viewW, int viewH)
+    {
+        if (mWorkers.empty())
+            return;
+
+        float ux = 0.0f, uy = 0.0f;
+        float len = std::sqrt(dx * dx + dy * dy);
+        if (len > 0.0f)
+        {
+            ux = dx / len;
+            uy = dy / len;
+        }
+        float ahead = len > 0.0f ? speed * LookaheadSeconds : 0.0f;
+        float px = cx + ux * ahead;
+        float py = cy + uy * ahead;
+
+        // viewport now and at the predicted position, with one chunk of margin
+        int minX = chunkOf((int)std::floor(std::min(cx, px) - viewW / 2.0f) - ChunkSize);
+        int maxX = chunkOf((int)std::floor(std::max(cx, px) + viewW / 2.0f) + ChunkSize);
+        int minY = chunkOf((int)std::floor(std::min(cy, py) - viewH / 2.0f) - ChunkSize);
+        int maxY = chunkOf((int)std::floor(std::max(cy, py) + viewH / 2.0f) + ChunkSize);
+        int aheadX = chunkOf((int)std::floor(px));
+        int aheadY = chunkOf((int)std::floor(py));
+
+        Plan plan{minX, minY, maxX, maxY, aheadX, aheadY};
+        if (plan == mPlan)
+            return;
+        mPlan = plan;
+
+        std::vector<ChunkCoord> wanted;
+        for (int y = minY; y <= maxY; ++y)
+            for (int x = minX; x <= maxX; ++x)
+                if (!mCache.contains(x, y))
+                    wanted.push_back({x, y});
+
+        // nearest to the predicted camera position first
+        std::sort(wanted.begin(), wanted.end(), [&](const ChunkCoord &a, const ChunkCoord &b)
+                  {
+                      int da = (a.x - aheadX) * (a.x - aheadX) + (a.y - aheadY) * (a.y - aheadY);
+                      int db = (b.x - aheadX) * (b.x - aheadX) + (b.y - aheadY) * (b.y - aheadY);
+                      return da < db; });
+
+        // never queue more than half the cache, prefetching must not evict the view
+        if (wanted.size() > mCache.capacity() / 2)
+            wanted.resize(mCache.capacity() / 2);
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mQueue.clear();
+            for (auto &c : wanted)
+                if (!mInFlight.count(chunkKey(c.x, c.y)))
+                    mQueue.push_back(c);
+        }
+        mWake.notify_all();
+    }
+
+private:
+    struct ChunkCoord
+    {
+        int x, y;
+    };
+
+    struct Plan
+    {
+        int minX, minY, maxX, maxY, aheadX, aheadY;
+
+        bool operator==(const Plan &o) const
+        {
+            return minX == o.minX && minY == o.minY && maxX == o.maxX && maxY == o.maxY &&
+                   aheadX == o.aheadX && aheadY == o.aheadY;
+        }
+    };
+
+    void workerLoop()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (true)
+        {
+            mWake.wait(lock, [this]
+                       { return mStop || !mQueue.empty(); });
+            if (mStop)
+                return;
+
+            ChunkCoord c = mQueue.front();
+            mQueue.pop_front();
+            std::uint64_t key = chunkKey(c.x, c.y);
+            mInFlight.insert(key);
+            lock.unlock();
+
+            mCache.prefetch(c.x, c.y);
+
+            lock.lock();
+            mInFlight.erase(key);
+        }
+    }
+
+    TerrainCache &mCache;
+    Plan mPlan{0, 0, -1, -1, 0, 0};
+    std::mutex mMutex;
+    std::condition_variable mWake;
+    std::deque<ChunkCoord> mQueue;
+    std::unordered_set<std::uint64_t> mInFlight;
+    bool mStop;
+    std::vector<std::thread> mWorkers;
+};
+
+#endif
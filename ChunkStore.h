@@ -0,0 +1,261 @@
+#ifndef CHUNKSTORE_H
+#define CHUNKSTORE_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include "Terrain.h"
+
+// Explored terrain of one universe, kept in a memory-mapped file so that
+// revisiting a chunk is a page-in rather than a regeneration.
+//
+// The file is a header page followed by fixed-size chunk slots that are only
+// ever appended. Each slot carries its own checksum and the index is rebuilt
+// by scanning the slots on open, so a crash can at worst lose the slot that
+// was being written; the header's count is only a hint for that scan.
+// The file grows with ftruncate and the mapping follows with mremap.
+class ChunkStore
+{
+public:
+    ChunkStore() = default;
+
+    ~ChunkStore() { close(); }
+
+    ChunkStore(const ChunkStore &) = delete;
+    ChunkStore &operator=(const ChunkStore &) = delete;
+
+    // Opens or creates the store at path. A store written for a different
+    // fingerprint (another noise configuration) is emptied. Returns false
+    // with errno set when the file cannot be used.
+    bool open(const std::string &path, uint64_t fingerprint)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        closeLocked();
+
+        mFd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (mFd < 0)
+            return false;
+
+        struct stat info;
+        if (fstat(mFd, &info) != 0)
+            return fail();
+
+        std::size_t bytes = (std::size_t)info.st_size;
+        bool fresh = bytes < HeaderBytes;
+        if (!fresh)
+        {
+            Header header;
+            fresh = pread(mFd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+                    std::memcmp(header.magic, Magic, sizeof(header.magic)) != 0 ||
+                    header.version != Version || header.slotBytes != sizeof(Slot) ||
+                    header.fingerprint != fingerprint;
+        }
+        if (fresh)
+        {
+            bytes = HeaderBytes + InitialSlots * sizeof(Slot);
+            if (ftruncate(mFd, 0) != 0 || ftruncate(mFd, (off_t)bytes) != 0)
+                return fail();
+        }
+
+        void *map = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+        if (map == MAP_FAILED)
+            return fail();
+        mMap = (char *)map;
+        mMapBytes = bytes;
+        mCapacity = (bytes - HeaderBytes) / sizeof(Slot);
+
+        Header *header = headerLocked();
+        if (fresh)
+        {
+            std::memset(header, 0, sizeof(Header));
+            std::memcpy(header->magic, Magic, sizeof(header->magic));
+            header->version = Version;
+            header->slotBytes = sizeof(Slot);
+            header->fingerprint = fingerprint;
+        }
+
+        // slots are appended in order, so the intact ones form a prefix
+        mCount = 0;
+        while (mCount < mCapacity && slotValid(*slotLocked(mCount)))
+        {
+            const Slot &slot = *slotLocked(mCount);
+            mIndex[chunkKey(slot.chunkX, slot.chunkY)] = mCount;
+            ++mCount;
+        }
+        // intact slots past a damaged one are dropped, so appends can never join them back up
+        for (std::size_t i = mCount; i < mCapacity && slotLocked(i)->used != 0; ++i)
+            slotLocked(i)->used = 0;
+        header->count = mCount;
+        return true;
+    }
+
+    bool isOpen() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mMap != nullptr;
+    }
+
+    // chunks held by the store
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mCount;
+    }
+
+    // Copies a stored chunk out, false if it was never stored
+    bool read(int chunkX, int chunkY, TerrainChunk &chunk) const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mIndex.find(chunkKey(chunkX, chunkY));
+        if (it == mIndex.end())
+            return false;
+        chunk = slotLocked(it->second)->chunk;
+        return true;
+    }
+
+    // Appends a chunk unless it is already stored; false if the file could not grow
+    bool write(int chunkX, int chunkY, const TerrainChunk &chunk)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mMap)
+            return false;
+        std::uint64_t key = chunkKey(chunkX, chunkY);
+        if (mIndex.count(key))
+            return true;
+        if (mCount == mCapacity && !growLocked())
+            return false;
+
+        Slot *slot = slotLocked(mCount);
+        slot->chunkX = chunkX;
+        slot->chunkY = chunkY;
+        slot->chunk = chunk;
+        slot->checksum = checksum(*slot);
+        // the marker goes last, a slot is never seen as used before its contents are in place
+        __atomic_store_n(&slot->used, SlotUsed, __ATOMIC_RELEASE);
+
+        mIndex[key] = mCount;
+        ++mCount;
+        headerLocked()->count = mCount;
+        return true;
+    }
+
+    // Flushes the mapping to disk and closes the file
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        closeLocked();
+    }
+
+private:
+    static constexpr char Magic[8] = {'N', 'X', 'C', 'H', 'U', 'N', 'K', '\0'};
+    static const uint32_t Version = 1;
+    static const uint32_t SlotUsed = 0x544f4c53; // "SLOT"
+    static const std::size_t HeaderBytes = 4096;
+    static const std::size_t InitialSlots = 256;
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t slotBytes;
+        uint64_t fingerprint;
+        uint64_t count; // slots written when last updated, a hint only
+    };
+
+    struct Slot
+    {
+        uint32_t used;
+        uint32_t checksum;
+        int32_t chunkX, chunkY;
+        TerrainChunk chunk;
+    };
+
+    static_assert(sizeof(Header) <= HeaderBytes, "chunk store header does not fit its page");
+
+    // FNV-1a over the coordinates and cells
+    static uint32_t checksum(const Slot &slot)
+    {
+        uint32_t hash = 2166136261u;
+        auto mix = [&hash](const void *data, std::size_t size)
+        {
+            const unsigned char *bytes = (const unsigned char *)data;
+            for (std::size_t i = 0; i < size; ++i)
+                hash = (hash ^ bytes[i]) * 16777619u;
+        };
+        mix(&slot.chunkX, sizeof(slot.chunkX));
+        mix(&slot.chunkY, sizeof(slot.chunkY));
+        mix(&slot.chunk, sizeof(slot.chunk));
+        return hash;
+    }
+
+    static bool slotValid(const Slot &slot)
+    {
+        return slot.used == SlotUsed && slot.checksum == checksum(slot);
+    }
+
+    Header *headerLocked() const { return (Header *)mMap; }
+
+    Slot *slotLocked(std::size_t index) const
+    {
+        return (Slot *)(mMap + HeaderBytes) + index;
+    }
+
+    bool growLocked()
+    {
+        std::size_t capacity = std::max(mCapacity * 2, InitialSlots);
+        std::size_t bytes = HeaderBytes + capacity * sizeof(Slot);
+        if (ftruncate(mFd, (off_t)bytes) != 0)
+            return false;
+        void *map = mremap(mMap, mMapBytes, bytes, MREMAP_MAYMOVE);
+        if (map == MAP_FAILED)
+            return false;
+        mMap = (char *)map;
+        mMapBytes = bytes;
+        mCapacity = capacity;
+        return true;
+    }
+
+    bool fail()
+    {
+        int error = errno;
+        closeLocked();
+        errno = error;
+        return false;
+    }
+
+    void closeLocked()
+    {
+        if (mMap)
+        {
+            msync(mMap, mMapBytes, MS_SYNC);
+            munmap(mMap, mMapBytes);
+        }
+        if (mFd >= 0)
+            ::close(mFd);
+        mMap = nullptr;
+        mMapBytes = 0;
+        mFd = -1;
+        mCapacity = 0;
+        mCount = 0;
+        mIndex.clear();
+    }
+
+    int mFd = -1;
+    char *mMap = nullptr;
+    std::size_t mMapBytes = 0;
+    std::size_t mCapacity = 0;
+    std::size_t mCount = 0;
+    std::unordered_map<std::uint64_t, std::size_t> mIndex; // chunk key to slot
+    mutable std::mutex mMutex;
+};
+
+#endif
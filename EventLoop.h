@@ -0,0 +1,143 @@
+#ifndef EVENTLOOP_H
+#define EVENTLOOP_H
+
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+// Blocks the main thread until there is something to do: input on a file
+// descriptor, the frame timer firing, or a terminal signal arriving.
+// Signals are read through a signalfd, so they must be blocked in every
+// thread; construct this before starting any other threads.
+class EventLoop
+{
+public:
+    enum Event
+    {
+        Event_Input = 1 << 0,
+        Event_Timer = 1 << 1,
+        Event_Resize = 1 << 2, // SIGWINCH
+        Event_Quit = 1 << 3    // SIGTERM, SIGINT or SIGHUP
+    };
+
+    explicit EventLoop(int inputFd)
+        : mInputFd(inputFd)
+    {
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGWINCH);
+        sigaddset(&signals, SIGTERM);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGHUP);
+        pthread_sigmask(SIG_BLOCK, &signals, &mOldMask);
+
+        mEpollFd = epoll_create1(EPOLL_CLOEXEC);
+        mTimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        mSignalFd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+
+        watch(mInputFd, Event_Input);
+        watch(mTimerFd, Event_Timer);
+        watch(mSignalFd, Event_Resize | Event_Quit);
+    }
+
+    ~EventLoop()
+    {
+        if (mSignalFd >= 0)
+            close(mSignalFd);
+        if (mTimerFd >= 0)
+            close(mTimerFd);
+        if (mEpollFd >= 0)
+            close(mEpollFd);
+        pthread_sigmask(SIG_SETMASK, &mOldMask, nullptr);
+    }
+
+    EventLoop(const EventLoop &) = delete;
+    EventLoop &operator=(const EventLoop &) = delete;
+
+    bool ok() const { return mEpollFd >= 0 && mTimerFd >= 0 && mSignalFd >= 0; }
+
+    // Fires the timer every interval seconds until rearmed
+    void armPeriodic(float interval) { arm(interval, interval); }
+
+    // Fires the timer once after delay seconds
+    void armOnce(float delay) { arm(delay, 0.0f); }
+
+    // Waits for at least one event and returns the Event bits that are ready.
+    // Input is only reported, reading it is up to the caller.
+    int wait()
+    {
+        epoll_event ready[3];
+        int n;
+        do
+            n = epoll_wait(mEpollFd, ready, 3, -1);
+        while (n < 0 && errno == EINTR);
+        if (n < 0)
+            return Event_Quit;
+
+        int events = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            if (ready[i].data.u32 == Event_Input)
+            {
+                events |= Event_Input;
+            }
+            else if (ready[i].data.u32 == Event_Timer)
+            {
+                uint64_t expirations;
+                if (read(mTimerFd, &expirations, sizeof(expirations)) > 0)
+                    events |= Event_Timer;
+            }
+            else
+            {
+                signalfd_siginfo info;
+                while (read(mSignalFd, &info, sizeof(info)) == sizeof(info))
+                    events |= info.ssi_signo == SIGWINCH ? Event_Resize : Event_Quit;
+            }
+        }
+        return events;
+    }
+
+private:
+    void watch(int fd, int events)
+    {
+        if (mEpollFd < 0 || fd < 0)
+            return;
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u32 = events;
+        epoll_ctl(mEpollFd, EPOLL_CTL_ADD, fd, &ev);
+    }
+
+    static timespec toTimespec(float seconds)
+    {
+        timespec ts;
+        ts.tv_sec = (time_t)seconds;
+        ts.tv_nsec = (long)((seconds - (float)ts.tv_sec) * 1e9f);
+        // a zero value would disarm the timer instead of firing it
+        if (ts.tv_sec == 0 && ts.tv_nsec <= 0)
+            ts.tv_nsec = 1;
+        return ts;
+    }
+
+    void arm(float delay, float interval)
+    {
+        itimerspec spec{};
+        spec.it_value = toTimespec(delay);
+        if (interval > 0.0f)
+            spec.it_interval = toTimespec(interval);
+        timerfd_settime(mTimerFd, 0, &spec, nullptr);
+    }
+
+    int mInputFd;
+    int mEpollFd = -1;
+    int mTimerFd = -1;
+    int mSignalFd = -1;
+    sigset_t mOldMask;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#include "FastNoise.h"
+
+// Factory, one specialization per noise and fractal type with the octave count left to the settings.
+// Kept out of the header: instantiating every FastNoise is the bulk of a build, one file pays for it.
+
+namespace
+{
+    template <FastNoiseLite::NoiseType Noise>
+    std::unique_ptr<NoiseGenerator> MakeFastNoise(const FastNoiseLite& settings, FastNoiseLite::FractalType fractalType)
+    {
+        switch (fractalType)
+        {
+        default:
+            return std::make_unique<FastNoise<Noise, FastNoiseLite::FractalType_None>>(settings);
+        case FastNoiseLite::FractalType_FBm:
+            return std::make_unique<FastNoise<Noise, FastNoiseLite::FractalType_FBm>>(settings);
+        case FastNoiseLite::FractalType_Ridged:
+            return std::make_unique<FastNoise<Noise, FastNoiseLite::FractalType_Ridged>>(settings);
+        case FastNoiseLite::FractalType_PingPong:
+            return std::make_unique<FastNoise<Noise, FastNoiseLite::FractalType_PingPong>>(settings);
+        }
+    }
+}
+
+std::unique_ptr<NoiseGenerator> MakeFastNoise(const FastNoiseLite& settings)
+{
+    FastNoiseLite::FractalType fractalType = settings.GetFractalType();
+
+    switch (settings.GetNoiseType())
+    {
+    default:
+    case FastNoiseLite::NoiseType_OpenSimplex2:
+        return MakeFastNoise<FastNoiseLite::NoiseType_OpenSimplex2>(settings, fractalType);
+    case FastNoiseLite::NoiseType_OpenSimplex2S:
+        return MakeFastNoise<FastNoiseLite::NoiseType_OpenSimplex2S>(settings, fractalType);
+    case FastNoiseLite::NoiseType_Cellular:
+        return MakeFastNoise<FastNoiseLite::NoiseType_Cellular>(settings, fractalType);
+    case FastNoiseLite::NoiseType_Perlin:
+        return MakeFastNoise<FastNoiseLite::NoiseType_Perlin>(settings, fractalType);
+    case FastNoiseLite::NoiseType_ValueCubic:
+        return MakeFastNoise<FastNoiseLite::NoiseType_ValueCubic>(settings, fractalType);
+    case FastNoiseLite::NoiseType_Value:
+        return MakeFastNoise<FastNoiseLite::NoiseType_Value>(settings, fractalType);
+    }
+}
@@ -0,0 +1,452 @@
+#ifndef FASTNOISE_H
+#define FASTNOISE_H
+
+#include <memory>
+#include "FastNoiseLite.h"
+
+/// <summary>
+/// Runtime interface to a noise configuration, implemented by every FastNoise specialization
+/// </summary>
+/// <remarks>
+/// Dispatch through this interface happens once per call, so grids pay it once per grid
+/// rather than once per sample and octave.
+/// </remarks>
+class NoiseGenerator
+{
+public:
+    virtual ~NoiseGenerator() = default;
+
+    virtual float GetNoise(float x, float y) const = 0;
+    virtual float GetNoise(float x, float y, float z) const = 0;
+
+    virtual void GetNoise(const float* xs, const float* ys, float* out, int count) const = 0;
+    virtual void GetNoise(const float* xs, const float* ys, const float* zs, float* out, int count) const = 0;
+
+    virtual void GenGrid2D(float* out, int x0, int y0, int width, int height, float step = 1.0f) const = 0;
+    virtual void GenGrid3D(float* out, int x0, int y0, int z0, int width, int height, int depth, float step = 1.0f) const = 0;
+};
+
+/// <summary>
+/// FastNoiseLite with its noise and fractal type fixed at compile time
+/// </summary>
+/// <remarks>
+/// Output matches FastNoiseLite with the same settings. The per-sample and per-octave
+/// switches on the noise and fractal type are resolved by the compiler, so the noise
+/// function inlines into the octave loop. A non-zero Octaves also fixes the octave
+/// count, letting that loop unroll; 0 takes the count from the settings.
+/// Settings are copied at construction, later changes to the source are not seen.
+/// </remarks>
+template <FastNoiseLite::NoiseType Noise, FastNoiseLite::FractalType Fractal = FastNoiseLite::FractalType_None, int Octaves = 0>
+class FastNoise final : public NoiseGenerator
+{
+    static_assert(Fractal <= FastNoiseLite::FractalType_PingPong, "domain warp fractal types only apply to DomainWarp(...)");
+    static_assert(Octaves >= 0, "octave count must be positive, or 0 for the runtime count");
+
+public:
+    explicit FastNoise(const FastNoiseLite& settings = FastNoiseLite())
+        : mSettings(settings)
+    {
+        mSettings.SetNoiseType(Noise);
+        mSettings.SetFractalType(Fractal);
+        if (Octaves > 0)
+            mSettings.SetFractalOctaves(Octaves);
+    }
+
+    /// <summary>
+    /// 2D noise at given position, same as FastNoiseLite::GetNoise
+    /// </summary>
+    template <typename FNfloat>
+    float GetNoise(FNfloat x, FNfloat y) const
+    {
+        FastNoiseLite::Arguments_must_be_floating_point_values<FNfloat>();
+
+        TransformNoiseCoordinate(x, y);
+        return GenFractal(x, y);
+    }
+
+    /// <summary>
+    /// 3D noise at given position, same as FastNoiseLite::GetNoise
+    /// </summary>
+    template <typename FNfloat>
+    float GetNoise(FNfloat x, FNfloat y, FNfloat z) const
+    {
+        FastNoiseLite::Arguments_must_be_floating_point_values<FNfloat>();
+
+        mSettings.TransformNoiseCoordinate(x, y, z);
+        return GenFractal(x, y, z);
+    }
+
+    float GetNoise(float x, float y) const override { return GetNoise<float>(x, y); }
+
+    float GetNoise(float x, float y, float z) const override { return GetNoise<float>(x, y, z); }
+
+    /// <summary>
+    /// 2D noise at count positions held in separate x and y arrays, same as FastNoiseLite::GetNoise
+    /// </summary>
+    void GetNoise(const float* xs, const float* ys, float* out, int count) const override
+    {
+        float xb[BlockSize];
+        float yb[BlockSize];
+
+        for (int start = 0; start < count; start += BlockSize)
+        {
+            int n = count - start < BlockSize ? count - start : BlockSize;
+
+            for (int i = 0; i < n; i++)
+            {
+                xb[i] = xs[start + i];
+                yb[i] = ys[start + i];
+                TransformNoiseCoordinate(xb[i], yb[i]);
+            }
+
+            GenFractalBlock(xb, yb, out + start, n);
+        }
+    }
+
+    /// <summary>
+    /// 3D noise at count positions held in separate x, y and z arrays, same as FastNoiseLite::GetNoise
+    /// </summary>
+    void GetNoise(const float* xs, const float* ys, const float* zs, float* out, int count) const override
+    {
+        float xb[BlockSize];
+        float yb[BlockSize];
+        float zb[BlockSize];
+
+        for (int start = 0; start < count; start += BlockSize)
+        {
+            int n = count - start < BlockSize ? count - start : BlockSize;
+
+            for (int i = 0; i < n; i++)
+            {
+                xb[i] = xs[start + i];
+                yb[i] = ys[start + i];
+                zb[i] = zs[start + i];
+            }
+
+            mSettings.TransformNoiseCoordinateBlock(xb, yb, zb, n);
+            GenFractalBlock(xb, yb, zb, out + start, n);
+        }
+    }
+
+    /// <summary>
+    /// Fills a row-major buffer with 2D noise sampled on a regular grid, same as FastNoiseLite::GenGrid2D
+    /// </summary>
+    void GenGrid2D(float* out, int x0, int y0, int width, int height, float step = 1.0f) const override
+    {
+        float xs[BlockSize];
+        float ys[BlockSize];
+
+        int total = width * height;
+        int x = 0;
+        int y = 0;
+
+        for (int start = 0; start < total; start += BlockSize)
+        {
+            int count = total - start < BlockSize ? total - start : BlockSize;
+
+            for (int i = 0; i < count; i++)
+            {
+                xs[i] = x0 + x * step;
+                ys[i] = y0 + y * step;
+
+                if (++x == width)
+                {
+                    x = 0;
+                    y++;
+                }
+            }
+
+            for (int i = 0; i < count; i++)
+                TransformNoiseCoordinate(xs[i], ys[i]);
+            GenFractalBlock(xs, ys, out + start, count);
+        }
+    }
+
+    /// <summary>
+    /// Fills a row-major buffer with 3D noise sampled on a regular grid, same as FastNoiseLite::GenGrid3D
+    /// </summary>
+    void GenGrid3D(float* out, int x0, int y0, int z0, int width, int height, int depth, float step = 1.0f) const override
+    {
+        float xs[BlockSize];
+        float ys[BlockSize];
+        float zs[BlockSize];
+
+        int total = width * height * depth;
+        int x = 0;
+        int y = 0;
+        int z = 0;
+
+        for (int start = 0; start < total; start += BlockSize)
+        {
+            int count = total - start < BlockSize ? total - start : BlockSize;
+
+            for (int i = 0; i < count; i++)
+            {
+                xs[i] = x0 + x * step;
+                ys[i] = y0 + y * step;
+                zs[i] = z0 + z * step;
+
+                if (++x == width)
+                {
+                    x = 0;
+                    if (++y == height)
+                    {
+                        y = 0;
+                        z++;
+                    }
+                }
+            }
+
+            mSettings.TransformNoiseCoordinateBlock(xs, ys, zs, count);
+            GenFractalBlock(xs, ys, zs, out + start, count);
+        }
+    }
+
+private:
+    static const int BlockSize = FastNoiseLite::BlockSize;
+
+    int OctaveCount() const { return Octaves > 0 ? Octaves : mSettings.mOctaves; }
+
+    // Frequency and the OpenSimplex2 skew; the 3D transform also depends on the
+    // runtime rotation type so it stays with FastNoiseLite
+    template <typename FNfloat>
+    void TransformNoiseCoordinate(FNfloat& x, FNfloat& y) const
+    {
+        x *= mSettings.mFrequency;
+        y *= mSettings.mFrequency;
+
+        if constexpr (Noise == FastNoiseLite::NoiseType_OpenSimplex2 || Noise == FastNoiseLite::NoiseType_OpenSimplex2S)
+        {
+            const FNfloat SQRT3 = (FNfloat)1.7320508075688772935274463415059;
+            const FNfloat F2 = 0.5f * (SQRT3 - 1);
+            FNfloat t = (x + y) * F2;
+            x += t;
+            y += t;
+        }
+    }
+
+
+    // Noise, the switch of FastNoiseLite::GenNoiseSingle/GenNoiseBlock
+
+    template <typename FNfloat>
+    float GenNoiseSingle(int seed, FNfloat x, FNfloat y) const
+    {
+        if constexpr (Noise == FastNoiseLite::NoiseType_OpenSimplex2)
+            return mSettings.SingleSimplex(seed, x, y);
+        else if constexpr (Noise == FastNoiseLite::NoiseType_OpenSimplex2S)
+            return mSettings.SingleOpenSimplex2S(seed, x, y);
+        else if constexpr (Noise == FastNoiseLite::NoiseType_Cellular)
+            return mSettings.SingleCellular(seed, x, y);
+        else if constexpr (Noise == FastNoiseLite::NoiseType_Perlin)
+            return mSettings.SinglePerlin(seed, x, y);
+        else if constexpr (Noise == FastNoiseLite::NoiseType_ValueCubic)
+            return mSettings.SingleValueCubic(seed, x, y);
+        else
+            return mSettings.SingleValue(seed, x, y);
+    }
+
+    template <typename FNfloat>
+    float GenNoiseSingle(int seed, FNfloat x, FNfloat y, FNfloat z) const
+    {
+        if constexpr (Noise == FastNoiseLite::NoiseType_OpenSimplex2)
+            return mSettings.SingleOpenSimplex2(seed, x, y, z);
+        else if constexpr (Noise == FastNoiseLite::NoiseType_OpenSimplex2S)
+            return mSettings.SingleOpenSimplex2S(seed, x, y, z);
+        else if constexpr (Noise == FastNoiseLite::NoiseType_Cellular)
+            return mSettings.SingleCellular(seed, x, y, z);
+        else if constexpr (Noise == FastNoiseLite::NoiseType_Perlin)
+            return mSettings.SinglePerlin(seed, x, y, z);
+        else if constexpr (Noise == FastNoiseLite::NoiseType_ValueCubic)
+            return mSettings.SingleValueCubic(seed, x, y, z);
+        else
+            return mSettings.SingleValue(seed, x, y, z);
+    }
+
+    void GenNoiseBlock(int seed, const float* xs, const float* ys, float* out, int count) const
+    {
+        if constexpr (Noise == FastNoiseLite::NoiseType_OpenSimplex2)
+            mSettings.SingleSimplexBlock(seed, xs, ys, out, count);
+        else if constexpr (Noise == FastNoiseLite::NoiseType_Cellular)
+            mSettings.SingleCellularBlock(seed, xs, ys, out, count);
+        else if constexpr (Noise == FastNoiseLite::NoiseType_Perlin)
+            mSettings.SinglePerlinBlock(seed, xs, ys, out, count);
+        else if constexpr (Noise == FastNoiseLite::NoiseType_ValueCubic)
+            mSettings.SingleValueCubicCoherent(seed, xs, ys, out, count);
+        else if constexpr (Noise == FastNoiseLite::NoiseType_Value)
+            mSettings.SingleValueCoherent(seed, xs, ys, out, count);
+        else
+            for (int i = 0; i < count; i++) out[i] = GenNoiseSingle(seed, xs[i], ys[i]);
+    }
+
+    void GenNoiseBlock(int seed, const float* xs, const float* ys, const float* zs, float* out, int count) const
+    {
+        if constexpr (Noise == FastNoiseLite::NoiseType_Perlin)
+            mSettings.SinglePerlinBlock(seed, xs, ys, zs, out, count);
+        else if constexpr (Noise == FastNoiseLite::NoiseType_ValueCubic)
+            mSettings.SingleValueCubicCoherent(seed, xs, ys, zs, out, count);
+        else if constexpr (Noise == FastNoiseLite::NoiseType_Value)
+            mSettings.SingleValueCoherent(seed, xs, ys, zs, out, count);
+        else
+            for (int i = 0; i < count; i++) out[i] = GenNoiseSingle(seed, xs[i], ys[i], zs[i]);
+    }
+
+
+    // Fractal, one octave's contribution to the sum; updates amp with the
+    // weighting but not the gain. 2D FBm clamps its weight like FastNoiseLite does
+
+    template <int Dimensions>
+    float Octave(float noise, float& amp) const
+    {
+        if constexpr (Fractal == FastNoiseLite::FractalType_FBm)
+        {
+            float value = noise * amp;
+            float weight = Dimensions == 2 ? FastNoiseLite::FastMin(noise + 1, 2) * 0.5f : (noise + 1) * 0.5f;
+            amp *= FastNoiseLite::Lerp(1.0f, weight, mSettings.mWeightedStrength);
+            return value;
+        }
+        else if constexpr (Fractal == FastNoiseLite::FractalType_Ridged)
+        {
+            float n = FastNoiseLite::FastAbs(noise);
+            float value = (n * -2 + 1) * amp;
+            amp *= FastNoiseLite::Lerp(1.0f, 1 - n, mSettings.mWeightedStrength);
+            return value;
+        }
+        else
+        {
+            float n = FastNoiseLite::PingPong((noise + 1) * mSettings.mPingPongStrength);
+            float value = (n - 0.5f) * 2 * amp;
+            amp *= FastNoiseLite::Lerp(1.0f, n, mSettings.mWeightedStrength);
+            return value;
+        }
+    }
+
+    template <typename FNfloat>
+    float GenFractal(FNfloat x, FNfloat y) const
+    {
+        if constexpr (Fractal == FastNoiseLite::FractalType_None)
+            return GenNoiseSingle(mSettings.mSeed, x, y);
+        else
+        {
+            int seed = mSettings.mSeed;
+            float sum = 0;
+            float amp = mSettings.mFractalBounding;
+
+            for (int i = 0; i < OctaveCount(); i++)
+            {
+                sum += Octave<2>(GenNoiseSingle(seed++, x, y), amp);
+
+                x *= mSettings.mLacunarity;
+                y *= mSettings.mLacunarity;
+                amp *= mSettings.mGain;
+            }
+
+            return sum;
+        }
+    }
+
+    template <typename FNfloat>
+    float GenFractal(FNfloat x, FNfloat y, FNfloat z) const
+    {
+        if constexpr (Fractal == FastNoiseLite::FractalType_None)
+            return GenNoiseSingle(mSettings.mSeed, x, y, z);
+        else
+        {
+            int seed = mSettings.mSeed;
+            float sum = 0;
+            float amp = mSettings.mFractalBounding;
+
+            for (int i = 0; i < OctaveCount(); i++)
+            {
+                sum += Octave<3>(GenNoiseSingle(seed++, x, y, z), amp);
+
+                x *= mSettings.mLacunarity;
+                y *= mSettings.mLacunarity;
+                z *= mSettings.mLacunarity;
+                amp *= mSettings.mGain;
+            }
+
+            return sum;
+        }
+    }
+
+    void GenFractalBlock(float* xs, float* ys, float* out, int count) const
+    {
+        if constexpr (Fractal == FastNoiseLite::FractalType_None)
+            GenNoiseBlock(mSettings.mSeed, xs, ys, out, count);
+        else
+        {
+            int seed = mSettings.mSeed;
+            float noise[BlockSize];
+            float amp[BlockSize];
+
+            for (int i = 0; i < count; i++)
+            {
+                out[i] = 0;
+                amp[i] = mSettings.mFractalBounding;
+            }
+
+            for (int o = 0; o < OctaveCount(); o++)
+            {
+                GenNoiseBlock(seed++, xs, ys, noise, count);
+
+                for (int i = 0; i < count; i++)
+                {
+                    out[i] += Octave<2>(noise[i], amp[i]);
+
+                    xs[i] *= mSettings.mLacunarity;
+                    ys[i] *= mSettings.mLacunarity;
+                    amp[i] *= mSettings.mGain;
+                }
+            }
+        }
+    }
+
+    void GenFractalBlock(float* xs, float* ys, float* zs, float* out, int count) const
+    {
+        if constexpr (Fractal == FastNoiseLite::FractalType_None)
+            GenNoiseBlock(mSettings.mSeed, xs, ys, zs, out, count);
+        else
+        {
+            int seed = mSettings.mSeed;
+            float noise[BlockSize];
+            float amp[BlockSize];
+
+            for (int i = 0; i < count; i++)
+            {
+                out[i] = 0;
+                amp[i] = mSettings.mFractalBounding;
+            }
+
+            for (int o = 0; o < OctaveCount(); o++)
+            {
+                GenNoiseBlock(seed++, xs, ys, zs, noise, count);
+
+                for (int i = 0; i < count; i++)
+                {
+                    out[i] += Octave<3>(noise[i], amp[i]);
+
+                    xs[i] *= mSettings.mLacunarity;
+                    ys[i] *= mSettings.mLacunarity;
+                    zs[i] *= mSettings.mLacunarity;
+                    amp[i] *= mSettings.mGain;
+                }
+            }
+        }
+    }
+
+    FastNoiseLite mSettings;
+};
+
+
+/// <summary>
+/// Creates the FastNoise specialization for the noise and fractal type of settings
+/// </summary>
+/// <remarks>
+/// The generator gives the same output as settings.GetNoise(...) and settings.GenGrid2D/3D(...).
+/// Domain warp fractal types do not affect noise, they get the FractalType_None specialization.
+/// The octave count stays with the settings; instantiate FastNoise directly to fix it.
+/// Defined in FastNoise.cpp, so only that file compiles every specialization.
+/// </remarks>
+std::unique_ptr<NoiseGenerator> MakeFastNoise(const FastNoiseLite& settings);
+
+#endif
@@ -52,6 +52,21 @@
 
 #include <cmath>
 
+// Batch kernels for Perlin, OpenSimplex2 and the 2D domain warps use SSE4.1/AVX2 when the
+// CPU supports them, other targets (and builds defining FNL_NO_SIMD) run the scalar path
+//
+// The batch generators (GenGrid*, GenGridMulti*, the array GetNoise and DomainWarp) give
+// the same bits as GetNoise/DomainWarp one position at a time, at every SimdLevel. That
+// holds only when the compiler does not fuse multiply-adds, which GCC does by default as
+// soon as FMA is enabled (-march=native): build with -ffp-contract=off, as the CMake
+// FastNoiseLite target does. Otherwise results differ in the last bits between paths.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(FNL_NO_SIMD)
+#define FNL_SIMD_X86
+#include <immintrin.h>
+#define FNL_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define FNL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
 class FastNoiseLite
 {
 public:
@@ -108,6 +123,13 @@ public:
         DomainWarpType_BasicGrid
     };
 
+    enum SimdLevel
+    {
+        SimdLevel_Scalar,
+        SimdLevel_SSE41,
+        SimdLevel_AVX2
+    };
+
     /// <summary>
     /// Create new FastNoise object with optional seed
     /// </summary>
@@ -135,6 +157,8 @@ public:
         mDomainWarpType = DomainWarpType_OpenSimplex2;
         mWarpTransformType3D = TransformType3D_DefaultOpenSimplex2;
         mDomainWarpAmp = 1.0f;
+
+        mSimdLevel = DetectSimdLevel();
     }
 
     /// <summary>
@@ -165,6 +189,11 @@ public:
         UpdateTransformType3D();
     }
 
+    /// <summary>
+    /// Returns noise algorithm used for GetNoise(...)
+    /// </summary>
+    NoiseType GetNoiseType() const { return mNoiseType; }
+
     /// <summary>
     /// Sets domain rotation type for 3D Noise and 3D DomainWarp.
     /// Can aid in reducing directional artifacts when sampling a 2D plane in 3D
@@ -188,6 +217,11 @@ public:
     /// </remarks>
     void SetFractalType(FractalType fractalType) { mFractalType = fractalType; }
 
+    /// <summary>
+    /// Returns method for combining octaves
+    /// </summary>
+    FractalType GetFractalType() const { return mFractalType; }
+
     /// <summary>
     /// Sets octave count for all fractal noise types 
     /// </summary>
@@ -286,6 +320,40 @@ public:
     void SetDomainWarpAmp(float domainWarpAmp) { mDomainWarpAmp = domainWarpAmp; }
 
 
+    /// <summary>
+    /// Sets the instruction set used by the batch generators for Perlin and OpenSimplex2 noise and 2D domain warp
+    /// </summary>
+    /// <remarks>
+    /// Default: Best level supported by the CPU
+    /// Note: Levels above what the CPU supports are clamped, all levels produce identical output (see the top of this file)
+    /// </remarks>
+    void SetSimdLevel(SimdLevel simdLevel)
+    {
+        SimdLevel supported = DetectSimdLevel();
+        mSimdLevel = simdLevel > supported ? supported : simdLevel;
+    }
+
+    /// <summary>
+    /// Returns the instruction set used by the batch generators
+    /// </summary>
+    SimdLevel GetSimdLevel() const { return mSimdLevel; }
+
+    /// <summary>
+    /// Returns the best instruction set supported by the running CPU
+    /// </summary>
+    static SimdLevel DetectSimdLevel()
+    {
+#ifdef FNL_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return SimdLevel_AVX2;
+        if (__builtin_cpu_supports("sse4.1"))
+            return SimdLevel_SSE41;
+#endif
+        return SimdLevel_Scalar;
+    }
+
+
     /// <summary>
     /// 2D noise at given position using current settings
     /// </summary>
@@ -338,6 +406,60 @@ public:
         }
     }
 
+    /// <summary>
+    /// 2D noise at given position using current settings, with its partial derivatives
+    /// </summary>
+    /// <remarks>
+    /// dx and dy receive the rate of change of the noise along x and y.
+    /// Perlin and OpenSimplex2, unfractaled or FBm, derive them from the same lattice
+    /// evaluation as the value; other noise and fractal types fall back to central differences
+    /// </remarks>
+    /// <returns>
+    /// Noise output bounded between -1...1, the same as GetNoise(x, y)
+    /// </returns>
+    template <typename FNfloat>
+    float GetNoiseWithDerivative(FNfloat x, FNfloat y, float& dx, float& dy) const
+    {
+        Arguments_must_be_floating_point_values<FNfloat>();
+
+        if (!HasAnalyticDerivative())
+            return GetNoiseFiniteDifference(x, y, dx, dy);
+
+        TransformNoiseCoordinate(x, y);
+
+        float value = mFractalType == FractalType_FBm ? GenFractalFBmDerivative(x, y, dx, dy)
+                                                      : GenNoiseSingleDerivative(mSeed, x, y, dx, dy);
+        TransformNoiseDerivative(dx, dy);
+        return value;
+    }
+
+    /// <summary>
+    /// 3D noise at given position using current settings, with its partial derivatives
+    /// </summary>
+    /// <remarks>
+    /// dx, dy and dz receive the rate of change of the noise along x, y and z.
+    /// Perlin and OpenSimplex2, unfractaled or FBm, derive them from the same lattice
+    /// evaluation as the value; other noise and fractal types fall back to central differences
+    /// </remarks>
+    /// <returns>
+    /// Noise output bounded between -1...1, the same as GetNoise(x, y, z)
+    /// </returns>
+    template <typename FNfloat>
+    float GetNoiseWithDerivative(FNfloat x, FNfloat y, FNfloat z, float& dx, float& dy, float& dz) const
+    {
+        Arguments_must_be_floating_point_values<FNfloat>();
+
+        if (!HasAnalyticDerivative())
+            return GetNoiseFiniteDifference(x, y, z, dx, dy, dz);
+
+        TransformNoiseCoordinate(x, y, z);
+
+        float value = mFractalType == FractalType_FBm ? GenFractalFBmDerivative(x, y, z, dx, dy, dz)
+                                                      : GenNoiseSingleDerivative(mSeed, x, y, z, dx, dy, dz);
+        TransformNoiseDerivative(dx, dy, dz);
+        return value;
+    }
+
 
     /// <summary>
     /// 2D warps the input position using current domain warp settings
@@ -393,7 +515,285 @@ public:
         }
     }
 
+
+    /// <summary>
+    /// Fills a row-major buffer with 2D noise sampled on a regular grid using current settings
+    /// </summary>
+    /// <remarks>
+    /// out must hold width * height values.
+    /// out[y * width + x] matches GetNoise(x0 + x * step, y0 + y * step)
+    /// </remarks>
+    void GenGrid2D(float* out, int x0, int y0, int width, int height, float step = 1.0f) const
+    {
+        float xs[BlockSize];
+        float ys[BlockSize];
+
+        int total = width * height;
+        int x = 0;
+        int y = 0;
+
+        for (int start = 0; start < total; start += BlockSize)
+        {
+            int count = total - start < BlockSize ? total - start : BlockSize;
+
+            for (int i = 0; i < count; i++)
+            {
+                xs[i] = x0 + x * step;
+                ys[i] = y0 + y * step;
+
+                if (++x == width)
+                {
+                    x = 0;
+                    y++;
+                }
+            }
+
+            TransformNoiseCoordinateBlock(xs, ys, count);
+            GenFractalBlock(xs, ys, out + start, count);
+        }
+    }
+
+    /// <summary>
+    /// Fills a row-major buffer with 3D noise sampled on a regular grid using current settings
+    /// </summary>
+    /// <remarks>
+    /// out must hold width * height * depth values.
+    /// out[(z * height + y) * width + x] matches GetNoise(x0 + x * step, y0 + y * step, z0 + z * step)
+    /// </remarks>
+    void GenGrid3D(float* out, int x0, int y0, int z0, int width, int height, int depth, float step = 1.0f) const
+    {
+        float xs[BlockSize];
+        float ys[BlockSize];
+        float zs[BlockSize];
+
+        int total = width * height * depth;
+        int x = 0;
+        int y = 0;
+        int z = 0;
+
+        for (int start = 0; start < total; start += BlockSize)
+        {
+            int count = total - start < BlockSize ? total - start : BlockSize;
+
+            for (int i = 0; i < count; i++)
+            {
+                xs[i] = x0 + x * step;
+                ys[i] = y0 + y * step;
+                zs[i] = z0 + z * step;
+
+                if (++x == width)
+                {
+                    x = 0;
+                    if (++y == height)
+                    {
+                        y = 0;
+                        z++;
+                    }
+                }
+            }
+
+            TransformNoiseCoordinateBlock(xs, ys, zs, count);
+            GenFractalBlock(xs, ys, zs, out + start, count);
+        }
+    }
+
+    /// <summary>
+    /// Fills one row-major buffer per seed with 2D noise sampled on a regular grid using current settings
+    /// </summary>
+    /// <remarks>
+    /// out[f] must hold width * height values and receives the grid GenGrid2D fills with the seed set to seeds[f].
+    /// The fields share their coordinate transform, and for Perlin and OpenSimplex2 their lattice
+    /// cells and falloffs, so this is cheaper than one GenGrid2D call per seed
+    /// </remarks>
+    void GenGridMulti2D(float* const* out, const int* seeds, int fields, int x0, int y0, int width, int height, float step = 1.0f) const
+    {
+        float xs[BlockSize];
+        float ys[BlockSize];
+        float* blockOut[MaxFields];
+
+        int total = width * height;
+
+        for (int first = 0; first < fields; first += MaxFields)
+        {
+            int n = fields - first < MaxFields ? fields - first : MaxFields;
+            int x = 0;
+            int y = 0;
+
+            for (int start = 0; start < total; start += BlockSize)
+            {
+                int count = total - start < BlockSize ? total - start : BlockSize;
+
+                for (int i = 0; i < count; i++)
+                {
+                    xs[i] = x0 + x * step;
+                    ys[i] = y0 + y * step;
+
+                    if (++x == width)
+                    {
+                        x = 0;
+                        y++;
+                    }
+                }
+
+                TransformNoiseCoordinateBlock(xs, ys, count);
+
+                for (int f = 0; f < n; f++) blockOut[f] = out[first + f] + start;
+                GenFractalMultiBlock(seeds + first, n, xs, ys, blockOut, count);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Fills one row-major buffer per seed with 3D noise sampled on a regular grid using current settings
+    /// </summary>
+    /// <remarks>
+    /// out[f] must hold width * height * depth values and receives the grid GenGrid3D fills with the seed set to seeds[f].
+    /// The fields share their coordinate transform, and for Perlin their lattice cells and falloffs
+    /// </remarks>
+    void GenGridMulti3D(float* const* out, const int* seeds, int fields, int x0, int y0, int z0, int width, int height, int depth, float step = 1.0f) const
+    {
+        float xs[BlockSize];
+        float ys[BlockSize];
+        float zs[BlockSize];
+        float* blockOut[MaxFields];
+
+        int total = width * height * depth;
+
+        for (int first = 0; first < fields; first += MaxFields)
+        {
+            int n = fields - first < MaxFields ? fields - first : MaxFields;
+            int x = 0;
+            int y = 0;
+            int z = 0;
+
+            for (int start = 0; start < total; start += BlockSize)
+            {
+                int count = total - start < BlockSize ? total - start : BlockSize;
+
+                for (int i = 0; i < count; i++)
+                {
+                    xs[i] = x0 + x * step;
+                    ys[i] = y0 + y * step;
+                    zs[i] = z0 + z * step;
+
+                    if (++x == width)
+                    {
+                        x = 0;
+                        if (++y == height)
+                        {
+                            y = 0;
+                            z++;
+                        }
+                    }
+                }
+
+                TransformNoiseCoordinateBlock(xs, ys, zs, count);
+
+                for (int f = 0; f < n; f++) blockOut[f] = out[first + f] + start;
+                GenFractalMultiBlock(seeds + first, n, xs, ys, zs, blockOut, count);
+            }
+        }
+    }
+
+    /// <summary>
+    /// 2D noise at count positions held in separate x and y arrays using current settings
+    /// </summary>
+    /// <remarks>
+    /// out[i] is the noise at (xs[i], ys[i]); the positions are left unchanged
+    /// </remarks>
+    void GetNoise(const float* xs, const float* ys, float* out, int count) const
+    {
+        float xb[BlockSize];
+        float yb[BlockSize];
+
+        for (int start = 0; start < count; start += BlockSize)
+        {
+            int n = count - start < BlockSize ? count - start : BlockSize;
+
+            for (int i = 0; i < n; i++)
+            {
+                xb[i] = xs[start + i];
+                yb[i] = ys[start + i];
+            }
+
+            TransformNoiseCoordinateBlock(xb, yb, n);
+            GenFractalBlock(xb, yb, out + start, n);
+        }
+    }
+
+    /// <summary>
+    /// 3D noise at count positions held in separate x, y and z arrays using current settings
+    /// </summary>
+    /// <remarks>
+    /// out[i] is the noise at (xs[i], ys[i], zs[i]); the positions are left unchanged
+    /// </remarks>
+    void GetNoise(const float* xs, const float* ys, const float* zs, float* out, int count) const
+    {
+        float xb[BlockSize];
+        float yb[BlockSize];
+        float zb[BlockSize];
+
+        for (int start = 0; start < count; start += BlockSize)
+        {
+            int n = count - start < BlockSize ? count - start : BlockSize;
+
+            for (int i = 0; i < n; i++)
+            {
+                xb[i] = xs[start + i];
+                yb[i] = ys[start + i];
+                zb[i] = zs[start + i];
+            }
+
+            TransformNoiseCoordinateBlock(xb, yb, zb, n);
+            GenFractalBlock(xb, yb, zb, out + start, n);
+        }
+    }
+
+    /// <summary>
+    /// 2D warps count positions held in separate x and y arrays in place using current domain warp settings
+    /// </summary>
+    /// <remarks>
+    /// Each position is replaced by its warped position, as DomainWarp(x, y) gives for one
+    /// </remarks>
+    /// <example>
+    /// Example usage with GetNoise
+    /// <code>DomainWarp(xs, ys, count)
+    /// GetNoise(xs, ys, out, count)</code>
+    /// </example>
+    void DomainWarp(float* xs, float* ys, int count) const
+    {
+        for (int start = 0; start < count; start += BlockSize)
+        {
+            int n = count - start < BlockSize ? count - start : BlockSize;
+            DomainWarpBlock(xs + start, ys + start, n);
+        }
+    }
+
+    /// <summary>
+    /// 3D warps count positions held in separate x, y and z arrays in place using current domain warp settings
+    /// </summary>
+    /// <remarks>
+    /// Each position is replaced by its warped position, as DomainWarp(x, y, z) gives for one
+    /// </remarks>
+    /// <example>
+    /// Example usage with GetNoise
+    /// <code>DomainWarp(xs, ys, zs, count)
+    /// GetNoise(xs, ys, zs, out, count)</code>
+    /// </example>
+    void DomainWarp(float* xs, float* ys, float* zs, int count) const
+    {
+        for (int start = 0; start < count; start += BlockSize)
+        {
+            int n = count - start < BlockSize ? count - start : BlockSize;
+            DomainWarpBlock(xs + start, ys + start, zs + start, n);
+        }
+    }
+
 private:
+    // compile-time specialized front-end, see FastNoise.h
+    template <NoiseType, FractalType, int>
+    friend class FastNoise;
+
     template <typename T>
     struct Arguments_must_be_floating_point_values;
 
@@ -428,6 +828,8 @@ private:
     TransformType3D mWarpTransformType3D;
     float mDomainWarpAmp;
 
+    SimdLevel mSimdLevel;
+
 
     template <typename T>
     struct Lookup
@@ -438,6 +840,12 @@ private:
         static const T RandVecs3D[];
     };
 
+    // Samples evaluated per dispatch by the grid generators
+    static const int BlockSize = 64;
+
+    // Fields the multi-field grid generators evaluate per pass
+    static const int MaxFields = 8;
+
     static float FastMin(float a, float b) { return a < b ? a : b; }
 
     static float FastMax(float a, float b) { return a > b ? a : b; }
@@ -458,6 +866,8 @@ private:
 
     static float InterpQuintic(float t) { return t * t * t * (t * (t * 6 - 15) + 10); }
 
+    static float InterpQuinticDerivative(float t) { return t * t * (t * (t * 30 - 60) + 30); }
+
     static float CubicLerp(float a, float b, float c, float d, float t)
     {
         float p = (d - c) - (a - b);
@@ -553,6 +963,32 @@ private:
     }
 
 
+    // Gradient vectors GradCoord takes its dot product with, for the lattice-coherent batches
+    // and the analytic derivatives
+
+    static void GradCoordVector(int seed, int xPrimed, int yPrimed, float& xg, float& yg)
+    {
+        int hash = Hash(seed, xPrimed, yPrimed);
+        hash ^= hash >> 15;
+        hash &= 127 << 1;
+
+        xg = Lookup<float>::Gradients2D[hash];
+        yg = Lookup<float>::Gradients2D[hash | 1];
+    }
+
+
+    static void GradCoordVector(int seed, int xPrimed, int yPrimed, int zPrimed, float& xg, float& yg, float& zg)
+    {
+        int hash = Hash(seed, xPrimed, yPrimed, zPrimed);
+        hash ^= hash >> 15;
+        hash &= 63 << 2;
+
+        xg = Lookup<float>::Gradients3D[hash];
+        yg = Lookup<float>::Gradients3D[hash | 1];
+        zg = Lookup<float>::Gradients3D[hash | 2];
+    }
+
+
     void GradCoordOut(int seed, int xPrimed, int yPrimed, float& xo, float& yo) const
     {
         int hash = Hash(seed, xPrimed, yPrimed) & (255 << 1);
@@ -658,47 +1094,135 @@ private:
     }
 
 
-    // Noise Coordinate Transforms (frequency, and possible skew or rotation)
+    // Block noise gen, dispatches once for a run of samples
 
-    template <typename FNfloat>
-    void TransformNoiseCoordinate(FNfloat& x, FNfloat& y) const
+    void GenNoiseBlock(int seed, const float* xs, const float* ys, float* out, int count) const
     {
-        x *= mFrequency;
-        y *= mFrequency;
-
         switch (mNoiseType)
         {
         case NoiseType_OpenSimplex2:
+            SingleSimplexBlock(seed, xs, ys, out, count);
+            break;
         case NoiseType_OpenSimplex2S:
-            {
-                const FNfloat SQRT3 = (FNfloat)1.7320508075688772935274463415059;
-                const FNfloat F2 = 0.5f * (SQRT3 - 1);
-                FNfloat t = (x + y) * F2;
-                x += t;
-                y += t;
-            }
+            for (int i = 0; i < count; i++) out[i] = SingleOpenSimplex2S(seed, xs[i], ys[i]);
+            break;
+        case NoiseType_Cellular:
+            SingleCellularBlock(seed, xs, ys, out, count);
+            break;
+        case NoiseType_Perlin:
+            SinglePerlinBlock(seed, xs, ys, out, count);
+            break;
+        case NoiseType_ValueCubic:
+            SingleValueCubicCoherent(seed, xs, ys, out, count);
+            break;
+        case NoiseType_Value:
+            SingleValueCoherent(seed, xs, ys, out, count);
             break;
         default:
+            for (int i = 0; i < count; i++) out[i] = 0;
             break;
         }
     }
 
-    template <typename FNfloat>
-    void TransformNoiseCoordinate(FNfloat& x, FNfloat& y, FNfloat& z) const
+    void GenNoiseBlock(int seed, const float* xs, const float* ys, const float* zs, float* out, int count) const
     {
-        x *= mFrequency;
-        y *= mFrequency;
-        z *= mFrequency;
-
-        switch (mTransformType3D)
+        switch (mNoiseType)
         {
-        case TransformType3D_ImproveXYPlanes:
-            {
-                FNfloat xy = x + y;
-                FNfloat s2 = xy * -(FNfloat)0.211324865405187;
-                z *= (FNfloat)0.577350269189626;
-                x += s2 - z;
-                y = y + s2 - z;
+        case NoiseType_OpenSimplex2:
+            for (int i = 0; i < count; i++) out[i] = SingleOpenSimplex2(seed, xs[i], ys[i], zs[i]);
+            break;
+        case NoiseType_OpenSimplex2S:
+            for (int i = 0; i < count; i++) out[i] = SingleOpenSimplex2S(seed, xs[i], ys[i], zs[i]);
+            break;
+        case NoiseType_Cellular:
+            for (int i = 0; i < count; i++) out[i] = SingleCellular(seed, xs[i], ys[i], zs[i]);
+            break;
+        case NoiseType_Perlin:
+            SinglePerlinBlock(seed, xs, ys, zs, out, count);
+            break;
+        case NoiseType_ValueCubic:
+            SingleValueCubicCoherent(seed, xs, ys, zs, out, count);
+            break;
+        case NoiseType_Value:
+            SingleValueCoherent(seed, xs, ys, zs, out, count);
+            break;
+        default:
+            for (int i = 0; i < count; i++) out[i] = 0;
+            break;
+        }
+    }
+
+    void GenNoiseMultiBlock(const int* seeds, int fields, const float* xs, const float* ys, float* const* out, int count) const
+    {
+        switch (mNoiseType)
+        {
+        case NoiseType_OpenSimplex2:
+            SingleSimplexMultiBlock(seeds, fields, xs, ys, out, count);
+            break;
+        case NoiseType_Perlin:
+            SinglePerlinMultiBlock(seeds, fields, xs, ys, out, count);
+            break;
+        default:
+            for (int f = 0; f < fields; f++) GenNoiseBlock(seeds[f], xs, ys, out[f], count);
+            break;
+        }
+    }
+
+    void GenNoiseMultiBlock(const int* seeds, int fields, const float* xs, const float* ys, const float* zs, float* const* out, int count) const
+    {
+        switch (mNoiseType)
+        {
+        case NoiseType_Perlin:
+            SinglePerlinMultiBlock(seeds, fields, xs, ys, zs, out, count);
+            break;
+        default:
+            for (int f = 0; f < fields; f++) GenNoiseBlock(seeds[f], xs, ys, zs, out[f], count);
+            break;
+        }
+    }
+
+
+    // Noise Coordinate Transforms (frequency, and possible skew or rotation)
+
+    template <typename FNfloat>
+    void TransformNoiseCoordinate(FNfloat& x, FNfloat& y) const
+    {
+        x *= mFrequency;
+        y *= mFrequency;
+
+        switch (mNoiseType)
+        {
+        case NoiseType_OpenSimplex2:
+        case NoiseType_OpenSimplex2S:
+            {
+                const FNfloat SQRT3 = (FNfloat)1.7320508075688772935274463415059;
+                const FNfloat F2 = 0.5f * (SQRT3 - 1);
+                FNfloat t = (x + y) * F2;
+                x += t;
+                y += t;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    template <typename FNfloat>
+    void TransformNoiseCoordinate(FNfloat& x, FNfloat& y, FNfloat& z) const
+    {
+        x *= mFrequency;
+        y *= mFrequency;
+        z *= mFrequency;
+
+        switch (mTransformType3D)
+        {
+        case TransformType3D_ImproveXYPlanes:
+            {
+                FNfloat xy = x + y;
+                FNfloat s2 = xy * -(FNfloat)0.211324865405187;
+                z *= (FNfloat)0.577350269189626;
+                x += s2 - z;
+                y = y + s2 - z;
                 z += xy * (FNfloat)0.577350269189626;
             }
             break;
@@ -726,6 +1250,84 @@ private:
         }
     }
 
+    void TransformNoiseCoordinateBlock(float* xs, float* ys, int count) const
+    {
+        for (int i = 0; i < count; i++)
+        {
+            xs[i] *= mFrequency;
+            ys[i] *= mFrequency;
+        }
+
+        switch (mNoiseType)
+        {
+        case NoiseType_OpenSimplex2:
+        case NoiseType_OpenSimplex2S:
+            {
+                const float SQRT3 = (float)1.7320508075688772935274463415059;
+                const float F2 = 0.5f * (SQRT3 - 1);
+                for (int i = 0; i < count; i++)
+                {
+                    float t = (xs[i] + ys[i]) * F2;
+                    xs[i] += t;
+                    ys[i] += t;
+                }
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    void TransformNoiseCoordinateBlock(float* xs, float* ys, float* zs, int count) const
+    {
+        for (int i = 0; i < count; i++)
+        {
+            xs[i] *= mFrequency;
+            ys[i] *= mFrequency;
+            zs[i] *= mFrequency;
+        }
+
+        switch (mTransformType3D)
+        {
+        case TransformType3D_ImproveXYPlanes:
+            for (int i = 0; i < count; i++)
+            {
+                float xy = xs[i] + ys[i];
+                float s2 = xy * -(float)0.211324865405187;
+                zs[i] *= (float)0.577350269189626;
+                xs[i] += s2 - zs[i];
+                ys[i] = ys[i] + s2 - zs[i];
+                zs[i] += xy * (float)0.577350269189626;
+            }
+            break;
+        case TransformType3D_ImproveXZPlanes:
+            for (int i = 0; i < count; i++)
+            {
+                float xz = xs[i] + zs[i];
+                float s2 = xz * -(float)0.211324865405187;
+                ys[i] *= (float)0.577350269189626;
+                xs[i] += s2 - ys[i];
+                zs[i] += s2 - ys[i];
+                ys[i] += xz * (float)0.577350269189626;
+            }
+            break;
+        case TransformType3D_DefaultOpenSimplex2:
+            {
+                const float R3 = (float)(2.0 / 3.0);
+                for (int i = 0; i < count; i++)
+                {
+                    float r = (xs[i] + ys[i] + zs[i]) * R3; // Rotation, not skew
+                    xs[i] = r - xs[i];
+                    ys[i] = r - ys[i];
+                    zs[i] = r - zs[i];
+                }
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
     void UpdateTransformType3D()
     {
         switch (mRotationType3D)
@@ -977,104 +1579,444 @@ private:
     }
 
 
-    // Simplex/OpenSimplex2 Noise
+    // Fractal Blocks, same octave math as the single sample versions applied to a run of samples
 
-    template <typename FNfloat>
-    float SingleSimplex(int seed, FNfloat x, FNfloat y) const
+    void GenFractalBlock(float* xs, float* ys, float* out, int count) const
     {
-        // 2D OpenSimplex2 case uses the same algorithm as ordinary Simplex.
+        switch (mFractalType)
+        {
+        default:
+            GenNoiseBlock(mSeed, xs, ys, out, count);
+            break;
+        case FractalType_FBm:
+            GenFractalFBmBlock(xs, ys, out, count);
+            break;
+        case FractalType_Ridged:
+            GenFractalRidgedBlock(xs, ys, out, count);
+            break;
+        case FractalType_PingPong:
+            GenFractalPingPongBlock(xs, ys, out, count);
+            break;
+        }
+    }
 
-        const float SQRT3 = 1.7320508075688772935274463415059f;
-        const float G2 = (3 - SQRT3) / 6;
+    void GenFractalBlock(float* xs, float* ys, float* zs, float* out, int count) const
+    {
+        switch (mFractalType)
+        {
+        default:
+            GenNoiseBlock(mSeed, xs, ys, zs, out, count);
+            break;
+        case FractalType_FBm:
+            GenFractalFBmBlock(xs, ys, zs, out, count);
+            break;
+        case FractalType_Ridged:
+            GenFractalRidgedBlock(xs, ys, zs, out, count);
+            break;
+        case FractalType_PingPong:
+            GenFractalPingPongBlock(xs, ys, zs, out, count);
+            break;
+        }
+    }
 
-        /*
-         * --- Skew moved to TransformNoiseCoordinate method ---
-         * const FNfloat F2 = 0.5f * (SQRT3 - 1);
-         * FNfloat s = (x + y) * F2;
-         * x += s; y += s;
-        */
+    void GenFractalFBmBlock(float* xs, float* ys, float* out, int count) const
+    {
+        int seed = mSeed;
+        float noise[BlockSize];
+        float amp[BlockSize];
 
-        int i = FastFloor(x);
-        int j = FastFloor(y);
-        float xi = (float)(x - i);
-        float yi = (float)(y - j);
+        for (int i = 0; i < count; i++)
+        {
+            out[i] = 0;
+            amp[i] = mFractalBounding;
+        }
 
-        float t = (xi + yi) * G2;
-        float x0 = (float)(xi - t);
-        float y0 = (float)(yi - t);
+        for (int o = 0; o < mOctaves; o++)
+        {
+            GenNoiseBlock(seed++, xs, ys, noise, count);
 
-        i *= PrimeX;
-        j *= PrimeY;
+            for (int i = 0; i < count; i++)
+            {
+                out[i] += noise[i] * amp[i];
+                amp[i] *= Lerp(1.0f, FastMin(noise[i] + 1, 2) * 0.5f, mWeightedStrength);
 
-        float n0, n1, n2;
+                xs[i] *= mLacunarity;
+                ys[i] *= mLacunarity;
+                amp[i] *= mGain;
+            }
+        }
+    }
 
-        float a = 0.5f - x0 * x0 - y0 * y0;
-        if (a <= 0) n0 = 0;
-        else
+    void GenFractalFBmBlock(float* xs, float* ys, float* zs, float* out, int count) const
+    {
+        int seed = mSeed;
+        float noise[BlockSize];
+        float amp[BlockSize];
+
+        for (int i = 0; i < count; i++)
         {
-            n0 = (a * a) * (a * a) * GradCoord(seed, i, j, x0, y0);
+            out[i] = 0;
+            amp[i] = mFractalBounding;
         }
 
-        float c = (float)(2 * (1 - 2 * G2) * (1 / G2 - 2)) * t + ((float)(-2 * (1 - 2 * G2) * (1 - 2 * G2)) + a);
-        if (c <= 0) n2 = 0;
-        else
+        for (int o = 0; o < mOctaves; o++)
         {
-            float x2 = x0 + (2 * (float)G2 - 1);
-            float y2 = y0 + (2 * (float)G2 - 1);
-            n2 = (c * c) * (c * c) * GradCoord(seed, i + PrimeX, j + PrimeY, x2, y2);
+            GenNoiseBlock(seed++, xs, ys, zs, noise, count);
+
+            for (int i = 0; i < count; i++)
+            {
+                out[i] += noise[i] * amp[i];
+                amp[i] *= Lerp(1.0f, (noise[i] + 1) * 0.5f, mWeightedStrength);
+
+                xs[i] *= mLacunarity;
+                ys[i] *= mLacunarity;
+                zs[i] *= mLacunarity;
+                amp[i] *= mGain;
+            }
         }
+    }
 
-        if (y0 > x0)
+    void GenFractalRidgedBlock(float* xs, float* ys, float* out, int count) const
+    {
+        int seed = mSeed;
+        float noise[BlockSize];
+        float amp[BlockSize];
+
+        for (int i = 0; i < count; i++)
         {
-            float x1 = x0 + (float)G2;
-            float y1 = y0 + ((float)G2 - 1);
-            float b = 0.5f - x1 * x1 - y1 * y1;
-            if (b <= 0) n1 = 0;
-            else
+            out[i] = 0;
+            amp[i] = mFractalBounding;
+        }
+
+        for (int o = 0; o < mOctaves; o++)
+        {
+            GenNoiseBlock(seed++, xs, ys, noise, count);
+
+            for (int i = 0; i < count; i++)
             {
-                n1 = (b * b) * (b * b) * GradCoord(seed, i, j + PrimeY, x1, y1);
+                float n = FastAbs(noise[i]);
+                out[i] += (n * -2 + 1) * amp[i];
+                amp[i] *= Lerp(1.0f, 1 - n, mWeightedStrength);
+
+                xs[i] *= mLacunarity;
+                ys[i] *= mLacunarity;
+                amp[i] *= mGain;
             }
         }
-        else
+    }
+
+    void GenFractalRidgedBlock(float* xs, float* ys, float* zs, float* out, int count) const
+    {
+        int seed = mSeed;
+        float noise[BlockSize];
+        float amp[BlockSize];
+
+        for (int i = 0; i < count; i++)
         {
-            float x1 = x0 + ((float)G2 - 1);
-            float y1 = y0 + (float)G2;
-            float b = 0.5f - x1 * x1 - y1 * y1;
-            if (b <= 0) n1 = 0;
-            else
+            out[i] = 0;
+            amp[i] = mFractalBounding;
+        }
+
+        for (int o = 0; o < mOctaves; o++)
+        {
+            GenNoiseBlock(seed++, xs, ys, zs, noise, count);
+
+            for (int i = 0; i < count; i++)
             {
-                n1 = (b * b) * (b * b) * GradCoord(seed, i + PrimeX, j, x1, y1);
+                float n = FastAbs(noise[i]);
+                out[i] += (n * -2 + 1) * amp[i];
+                amp[i] *= Lerp(1.0f, 1 - n, mWeightedStrength);
+
+                xs[i] *= mLacunarity;
+                ys[i] *= mLacunarity;
+                zs[i] *= mLacunarity;
+                amp[i] *= mGain;
             }
         }
-
-        return (n0 + n1 + n2) * 99.83685446303647f;
     }
 
-    template <typename FNfloat>
-    float SingleOpenSimplex2(int seed, FNfloat x, FNfloat y, FNfloat z) const
+    void GenFractalPingPongBlock(float* xs, float* ys, float* out, int count) const
     {
-        // 3D OpenSimplex2 case uses two offset rotated cube grids.
+        int seed = mSeed;
+        float noise[BlockSize];
+        float amp[BlockSize];
 
-        /*
-         * --- Rotation moved to TransformNoiseCoordinate method ---
-         * const FNfloat R3 = (FNfloat)(2.0 / 3.0);
-         * FNfloat r = (x + y + z) * R3; // Rotation, not skew
-         * x = r - x; y = r - y; z = r - z;
-        */
+        for (int i = 0; i < count; i++)
+        {
+            out[i] = 0;
+            amp[i] = mFractalBounding;
+        }
 
-        int i = FastRound(x);
-        int j = FastRound(y);
-        int k = FastRound(z);
-        float x0 = (float)(x - i);
-        float y0 = (float)(y - j);
-        float z0 = (float)(z - k);
+        for (int o = 0; o < mOctaves; o++)
+        {
+            GenNoiseBlock(seed++, xs, ys, noise, count);
 
-        int xNSign = (int)(-1.0f - x0) | 1;
-        int yNSign = (int)(-1.0f - y0) | 1;
-        int zNSign = (int)(-1.0f - z0) | 1;
+            for (int i = 0; i < count; i++)
+            {
+                float n = PingPong((noise[i] + 1) * mPingPongStrength);
+                out[i] += (n - 0.5f) * 2 * amp[i];
+                amp[i] *= Lerp(1.0f, n, mWeightedStrength);
 
-        float ax0 = xNSign * -x0;
-        float ay0 = yNSign * -y0;
+                xs[i] *= mLacunarity;
+                ys[i] *= mLacunarity;
+                amp[i] *= mGain;
+            }
+        }
+    }
+
+    void GenFractalPingPongBlock(float* xs, float* ys, float* zs, float* out, int count) const
+    {
+        int seed = mSeed;
+        float noise[BlockSize];
+        float amp[BlockSize];
+
+        for (int i = 0; i < count; i++)
+        {
+            out[i] = 0;
+            amp[i] = mFractalBounding;
+        }
+
+        for (int o = 0; o < mOctaves; o++)
+        {
+            GenNoiseBlock(seed++, xs, ys, zs, noise, count);
+
+            for (int i = 0; i < count; i++)
+            {
+                float n = PingPong((noise[i] + 1) * mPingPongStrength);
+                out[i] += (n - 0.5f) * 2 * amp[i];
+                amp[i] *= Lerp(1.0f, n, mWeightedStrength);
+
+                xs[i] *= mLacunarity;
+                ys[i] *= mLacunarity;
+                zs[i] *= mLacunarity;
+                amp[i] *= mGain;
+            }
+        }
+    }
+
+
+    // Multi-field Fractal Blocks, every field runs its own octave seeds over the shared coordinates
+
+    void GenFractalMultiBlock(const int* seeds, int fields, float* xs, float* ys, float* const* out, int count) const
+    {
+        if (mFractalType != FractalType_FBm && mFractalType != FractalType_Ridged && mFractalType != FractalType_PingPong)
+        {
+            GenNoiseMultiBlock(seeds, fields, xs, ys, out, count);
+            return;
+        }
+
+        int octaveSeeds[MaxFields];
+        float noise[MaxFields][BlockSize];
+        float amp[MaxFields][BlockSize];
+        float* noiseOut[MaxFields];
+
+        for (int f = 0; f < fields; f++)
+        {
+            octaveSeeds[f] = seeds[f];
+            noiseOut[f] = noise[f];
+
+            for (int i = 0; i < count; i++)
+            {
+                out[f][i] = 0;
+                amp[f][i] = mFractalBounding;
+            }
+        }
+
+        for (int o = 0; o < mOctaves; o++)
+        {
+            GenNoiseMultiBlock(octaveSeeds, fields, xs, ys, noiseOut, count);
+
+            for (int f = 0; f < fields; f++)
+            {
+                AccumulateOctaveBlock(noise[f], out[f], amp[f], count, true);
+                octaveSeeds[f]++;
+            }
+
+            for (int i = 0; i < count; i++)
+            {
+                xs[i] *= mLacunarity;
+                ys[i] *= mLacunarity;
+            }
+        }
+    }
+
+    void GenFractalMultiBlock(const int* seeds, int fields, float* xs, float* ys, float* zs, float* const* out, int count) const
+    {
+        if (mFractalType != FractalType_FBm && mFractalType != FractalType_Ridged && mFractalType != FractalType_PingPong)
+        {
+            GenNoiseMultiBlock(seeds, fields, xs, ys, zs, out, count);
+            return;
+        }
+
+        int octaveSeeds[MaxFields];
+        float noise[MaxFields][BlockSize];
+        float amp[MaxFields][BlockSize];
+        float* noiseOut[MaxFields];
+
+        for (int f = 0; f < fields; f++)
+        {
+            octaveSeeds[f] = seeds[f];
+            noiseOut[f] = noise[f];
+
+            for (int i = 0; i < count; i++)
+            {
+                out[f][i] = 0;
+                amp[f][i] = mFractalBounding;
+            }
+        }
+
+        for (int o = 0; o < mOctaves; o++)
+        {
+            GenNoiseMultiBlock(octaveSeeds, fields, xs, ys, zs, noiseOut, count);
+
+            for (int f = 0; f < fields; f++)
+            {
+                AccumulateOctaveBlock(noise[f], out[f], amp[f], count, false);
+                octaveSeeds[f]++;
+            }
+
+            for (int i = 0; i < count; i++)
+            {
+                xs[i] *= mLacunarity;
+                ys[i] *= mLacunarity;
+                zs[i] *= mLacunarity;
+            }
+        }
+    }
+
+    // One octave of the current fractal type added to a field, the 2D FBm weight clamps its noise like GenFractalFBm 2D does
+    void AccumulateOctaveBlock(const float* noise, float* out, float* amp, int count, bool clampWeight) const
+    {
+        switch (mFractalType)
+        {
+        default:
+            for (int i = 0; i < count; i++)
+            {
+                out[i] += noise[i] * amp[i];
+                amp[i] *= Lerp(1.0f, (clampWeight ? FastMin(noise[i] + 1, 2) : noise[i] + 1) * 0.5f, mWeightedStrength);
+                amp[i] *= mGain;
+            }
+            break;
+        case FractalType_Ridged:
+            for (int i = 0; i < count; i++)
+            {
+                float n = FastAbs(noise[i]);
+                out[i] += (n * -2 + 1) * amp[i];
+                amp[i] *= Lerp(1.0f, 1 - n, mWeightedStrength);
+                amp[i] *= mGain;
+            }
+            break;
+        case FractalType_PingPong:
+            for (int i = 0; i < count; i++)
+            {
+                float n = PingPong((noise[i] + 1) * mPingPongStrength);
+                out[i] += (n - 0.5f) * 2 * amp[i];
+                amp[i] *= Lerp(1.0f, n, mWeightedStrength);
+                amp[i] *= mGain;
+            }
+            break;
+        }
+    }
+
+
+    // Simplex/OpenSimplex2 Noise
+
+    template <typename FNfloat>
+    float SingleSimplex(int seed, FNfloat x, FNfloat y) const
+    {
+        // 2D OpenSimplex2 case uses the same algorithm as ordinary Simplex.
+
+        const float SQRT3 = 1.7320508075688772935274463415059f;
+        const float G2 = (3 - SQRT3) / 6;
+
+        /*
+         * --- Skew moved to TransformNoiseCoordinate method ---
+         * const FNfloat F2 = 0.5f * (SQRT3 - 1);
+         * FNfloat s = (x + y) * F2;
+         * x += s; y += s;
+        */
+
+        int i = FastFloor(x);
+        int j = FastFloor(y);
+        float xi = (float)(x - i);
+        float yi = (float)(y - j);
+
+        float t = (xi + yi) * G2;
+        float x0 = (float)(xi - t);
+        float y0 = (float)(yi - t);
+
+        i *= PrimeX;
+        j *= PrimeY;
+
+        float n0, n1, n2;
+
+        float a = 0.5f - x0 * x0 - y0 * y0;
+        if (a <= 0) n0 = 0;
+        else
+        {
+            n0 = (a * a) * (a * a) * GradCoord(seed, i, j, x0, y0);
+        }
+
+        float c = (float)(2 * (1 - 2 * G2) * (1 / G2 - 2)) * t + ((float)(-2 * (1 - 2 * G2) * (1 - 2 * G2)) + a);
+        if (c <= 0) n2 = 0;
+        else
+        {
+            float x2 = x0 + (2 * (float)G2 - 1);
+            float y2 = y0 + (2 * (float)G2 - 1);
+            n2 = (c * c) * (c * c) * GradCoord(seed, i + PrimeX, j + PrimeY, x2, y2);
+        }
+
+        if (y0 > x0)
+        {
+            float x1 = x0 + (float)G2;
+            float y1 = y0 + ((float)G2 - 1);
+            float b = 0.5f - x1 * x1 - y1 * y1;
+            if (b <= 0) n1 = 0;
+            else
+            {
+                n1 = (b * b) * (b * b) * GradCoord(seed, i, j + PrimeY, x1, y1);
+            }
+        }
+        else
+        {
+            float x1 = x0 + ((float)G2 - 1);
+            float y1 = y0 + (float)G2;
+            float b = 0.5f - x1 * x1 - y1 * y1;
+            if (b <= 0) n1 = 0;
+            else
+            {
+                n1 = (b * b) * (b * b) * GradCoord(seed, i + PrimeX, j, x1, y1);
+            }
+        }
+
+        return (n0 + n1 + n2) * 99.83685446303647f;
+    }
+
+    template <typename FNfloat>
+    float SingleOpenSimplex2(int seed, FNfloat x, FNfloat y, FNfloat z) const
+    {
+        // 3D OpenSimplex2 case uses two offset rotated cube grids.
+
+        /*
+         * --- Rotation moved to TransformNoiseCoordinate method ---
+         * const FNfloat R3 = (FNfloat)(2.0 / 3.0);
+         * FNfloat r = (x + y + z) * R3; // Rotation, not skew
+         * x = r - x; y = r - y; z = r - z;
+        */
+
+        int i = FastRound(x);
+        int j = FastRound(y);
+        int k = FastRound(z);
+        float x0 = (float)(x - i);
+        float y0 = (float)(y - j);
+        float z0 = (float)(z - k);
+
+        int xNSign = (int)(-1.0f - x0) | 1;
+        int yNSign = (int)(-1.0f - y0) | 1;
+        int zNSign = (int)(-1.0f - z0) | 1;
+
+        float ax0 = xNSign * -x0;
+        float ay0 = yNSign * -y0;
         float az0 = zNSign * -z0;
 
         i *= PrimeX;
@@ -1479,6 +2421,41 @@ private:
 
     // Cellular Noise
 
+    // The configured return type from the closest and second closest distances
+    float CellularReturn(float distance0, float distance1, int closestHash) const
+    {
+        if (mCellularDistanceFunction == CellularDistanceFunction_Euclidean && mCellularReturnType >= CellularReturnType_Distance)
+        {
+            distance0 = FastSqrt(distance0);
+
+            if (mCellularReturnType >= CellularReturnType_Distance2)
+            {
+                distance1 = FastSqrt(distance1);
+            }
+        }
+
+        switch (mCellularReturnType)
+        {
+        case CellularReturnType_CellValue:
+            return closestHash * (1 / 2147483648.0f);
+        case CellularReturnType_Distance:
+            return distance0 - 1;
+        case CellularReturnType_Distance2:
+            return distance1 - 1;
+        case CellularReturnType_Distance2Add:
+            return (distance1 + distance0) * 0.5f - 1;
+        case CellularReturnType_Distance2Sub:
+            return distance1 - distance0 - 1;
+        case CellularReturnType_Distance2Mul:
+            return distance1 * distance0 * 0.5f - 1;
+        case CellularReturnType_Distance2Div:
+            return distance0 / distance1 - 1;
+        default:
+            return 0;
+        }
+    }
+
+
     template <typename FNfloat>
     float SingleCellular(int seed, FNfloat x, FNfloat y) const
     {
@@ -1578,35 +2555,7 @@ private:
             break;
         }
 
-        if (mCellularDistanceFunction == CellularDistanceFunction_Euclidean && mCellularReturnType >= CellularReturnType_Distance)
-        {
-            distance0 = FastSqrt(distance0);
-
-            if (mCellularReturnType >= CellularReturnType_Distance2)
-            {
-                distance1 = FastSqrt(distance1);
-            }
-        }
-
-        switch (mCellularReturnType)
-        {
-        case CellularReturnType_CellValue:
-            return closestHash * (1 / 2147483648.0f);
-        case CellularReturnType_Distance:
-            return distance0 - 1;
-        case CellularReturnType_Distance2:
-            return distance1 - 1;
-        case CellularReturnType_Distance2Add:
-            return (distance1 + distance0) * 0.5f - 1;
-        case CellularReturnType_Distance2Sub:
-            return distance1 - distance0 - 1;
-        case CellularReturnType_Distance2Mul:
-            return distance1 * distance0 * 0.5f - 1;
-        case CellularReturnType_Distance2Div:
-            return distance0 / distance1 - 1;
-        default:
-            return 0;
-        }
+        return CellularReturn(distance0, distance1, closestHash);
     }
 
     template <typename FNfloat>
@@ -1732,36 +2681,8 @@ private:
             break;
         }
 
-        if (mCellularDistanceFunction == CellularDistanceFunction_Euclidean && mCellularReturnType >= CellularReturnType_Distance)
-        {
-            distance0 = FastSqrt(distance0);
-
-            if (mCellularReturnType >= CellularReturnType_Distance2)
-            {
-                distance1 = FastSqrt(distance1);
-            }
-        }
-
-        switch (mCellularReturnType)
-        {
-        case CellularReturnType_CellValue:
-            return closestHash * (1 / 2147483648.0f);
-        case CellularReturnType_Distance:
-            return distance0 - 1;
-        case CellularReturnType_Distance2:
-            return distance1 - 1;
-        case CellularReturnType_Distance2Add:
-            return (distance1 + distance0) * 0.5f - 1;
-        case CellularReturnType_Distance2Sub:
-            return distance1 - distance0 - 1;
-        case CellularReturnType_Distance2Mul:
-            return distance1 * distance0 * 0.5f - 1;
-        case CellularReturnType_Distance2Div:
-            return distance0 / distance1 - 1;
-        default:
-            return 0;
-        }
-    }
+        return CellularReturn(distance0, distance1, closestHash);
+    }
 
 
     // Perlin Noise
@@ -1828,419 +2749,347 @@ private:
     }
 
 
-    // Value Cubic Noise
-
-    template <typename FNfloat>
-    float SingleValueCubic(int seed, FNfloat x, FNfloat y) const
-    {
-        int x1 = FastFloor(x);
-        int y1 = FastFloor(y);
-
-        float xs = (float)(x - x1);
-        float ys = (float)(y - y1);
-
-        x1 *= PrimeX;
-        y1 *= PrimeY;
-        int x0 = x1 - PrimeX;
-        int y0 = y1 - PrimeY;
-        int x2 = x1 + PrimeX;
-        int y2 = y1 + PrimeY;
-        int x3 = x1 + (int)((long)PrimeX << 1);
-        int y3 = y1 + (int)((long)PrimeY << 1);
-
-        return CubicLerp(
-            CubicLerp(ValCoord(seed, x0, y0), ValCoord(seed, x1, y0), ValCoord(seed, x2, y0), ValCoord(seed, x3, y0),
-                      xs),
-            CubicLerp(ValCoord(seed, x0, y1), ValCoord(seed, x1, y1), ValCoord(seed, x2, y1), ValCoord(seed, x3, y1),
-                      xs),
-            CubicLerp(ValCoord(seed, x0, y2), ValCoord(seed, x1, y2), ValCoord(seed, x2, y2), ValCoord(seed, x3, y2),
-                      xs),
-            CubicLerp(ValCoord(seed, x0, y3), ValCoord(seed, x1, y3), ValCoord(seed, x2, y3), ValCoord(seed, x3, y3),
-                      xs),
-            ys) * (1 / (1.5f * 1.5f));
-    }
+    // Noise Derivatives, the same lattice evaluation as the single sample versions with the
+    // gradient of every term carried alongside. Values match GetNoise exactly; derivatives
+    // come out in the coordinates passed in and TransformNoiseDerivative takes them back
+    // through the frequency and skew/rotation to the caller's coordinates
 
-    template <typename FNfloat>
-    float SingleValueCubic(int seed, FNfloat x, FNfloat y, FNfloat z) const
+    bool HasAnalyticDerivative() const
     {
-        int x1 = FastFloor(x);
-        int y1 = FastFloor(y);
-        int z1 = FastFloor(z);
-
-        float xs = (float)(x - x1);
-        float ys = (float)(y - y1);
-        float zs = (float)(z - z1);
-
-        x1 *= PrimeX;
-        y1 *= PrimeY;
-        z1 *= PrimeZ;
-
-        int x0 = x1 - PrimeX;
-        int y0 = y1 - PrimeY;
-        int z0 = z1 - PrimeZ;
-        int x2 = x1 + PrimeX;
-        int y2 = y1 + PrimeY;
-        int z2 = z1 + PrimeZ;
-        int x3 = x1 + (int)((long)PrimeX << 1);
-        int y3 = y1 + (int)((long)PrimeY << 1);
-        int z3 = z1 + (int)((long)PrimeZ << 1);
-
-
-        return CubicLerp(
-            CubicLerp(
-                CubicLerp(ValCoord(seed, x0, y0, z0), ValCoord(seed, x1, y0, z0), ValCoord(seed, x2, y0, z0), ValCoord(seed, x3, y0, z0), xs),
-                CubicLerp(ValCoord(seed, x0, y1, z0), ValCoord(seed, x1, y1, z0), ValCoord(seed, x2, y1, z0), ValCoord(seed, x3, y1, z0), xs),
-                CubicLerp(ValCoord(seed, x0, y2, z0), ValCoord(seed, x1, y2, z0), ValCoord(seed, x2, y2, z0), ValCoord(seed, x3, y2, z0), xs),
-                CubicLerp(ValCoord(seed, x0, y3, z0), ValCoord(seed, x1, y3, z0), ValCoord(seed, x2, y3, z0), ValCoord(seed, x3, y3, z0), xs),
-                ys),
-            CubicLerp(
-                CubicLerp(ValCoord(seed, x0, y0, z1), ValCoord(seed, x1, y0, z1), ValCoord(seed, x2, y0, z1), ValCoord(seed, x3, y0, z1), xs),
-                CubicLerp(ValCoord(seed, x0, y1, z1), ValCoord(seed, x1, y1, z1), ValCoord(seed, x2, y1, z1), ValCoord(seed, x3, y1, z1), xs),
-                CubicLerp(ValCoord(seed, x0, y2, z1), ValCoord(seed, x1, y2, z1), ValCoord(seed, x2, y2, z1), ValCoord(seed, x3, y2, z1), xs),
-                CubicLerp(ValCoord(seed, x0, y3, z1), ValCoord(seed, x1, y3, z1), ValCoord(seed, x2, y3, z1), ValCoord(seed, x3, y3, z1), xs),
-                ys),
-            CubicLerp(
-                CubicLerp(ValCoord(seed, x0, y0, z2), ValCoord(seed, x1, y0, z2), ValCoord(seed, x2, y0, z2), ValCoord(seed, x3, y0, z2), xs),
-                CubicLerp(ValCoord(seed, x0, y1, z2), ValCoord(seed, x1, y1, z2), ValCoord(seed, x2, y1, z2), ValCoord(seed, x3, y1, z2), xs),
-                CubicLerp(ValCoord(seed, x0, y2, z2), ValCoord(seed, x1, y2, z2), ValCoord(seed, x2, y2, z2), ValCoord(seed, x3, y2, z2), xs),
-                CubicLerp(ValCoord(seed, x0, y3, z2), ValCoord(seed, x1, y3, z2), ValCoord(seed, x2, y3, z2), ValCoord(seed, x3, y3, z2), xs),
-                ys),
-            CubicLerp(
-                CubicLerp(ValCoord(seed, x0, y0, z3), ValCoord(seed, x1, y0, z3), ValCoord(seed, x2, y0, z3), ValCoord(seed, x3, y0, z3), xs),
-                CubicLerp(ValCoord(seed, x0, y1, z3), ValCoord(seed, x1, y1, z3), ValCoord(seed, x2, y1, z3), ValCoord(seed, x3, y1, z3), xs),
-                CubicLerp(ValCoord(seed, x0, y2, z3), ValCoord(seed, x1, y2, z3), ValCoord(seed, x2, y2, z3), ValCoord(seed, x3, y2, z3), xs),
-                CubicLerp(ValCoord(seed, x0, y3, z3), ValCoord(seed, x1, y3, z3), ValCoord(seed, x2, y3, z3), ValCoord(seed, x3, y3, z3), xs),
-                ys),
-            zs) * (1 / (1.5f * 1.5f * 1.5f));
+        return (mNoiseType == NoiseType_Perlin || mNoiseType == NoiseType_OpenSimplex2) &&
+               mFractalType != FractalType_Ridged && mFractalType != FractalType_PingPong;
     }
 
-
-    // Value Noise
-
+    // Central differences a thousandth of a noise feature either side, for the types without an analytic form
     template <typename FNfloat>
-    float SingleValue(int seed, FNfloat x, FNfloat y) const
+    float GetNoiseFiniteDifference(FNfloat x, FNfloat y, float& dx, float& dy) const
     {
-        int x0 = FastFloor(x);
-        int y0 = FastFloor(y);
-
-        float xs = InterpHermite((float)(x - x0));
-        float ys = InterpHermite((float)(y - y0));
-
-        x0 *= PrimeX;
-        y0 *= PrimeY;
-        int x1 = x0 + PrimeX;
-        int y1 = y0 + PrimeY;
+        FNfloat h = (FNfloat)(mFrequency != 0 ? 0.001f / FastAbs(mFrequency) : 0.001f);
 
-        float xf0 = Lerp(ValCoord(seed, x0, y0), ValCoord(seed, x1, y0), xs);
-        float xf1 = Lerp(ValCoord(seed, x0, y1), ValCoord(seed, x1, y1), xs);
+        FNfloat x0 = x - h, x1 = x + h;
+        FNfloat y0 = y - h, y1 = y + h;
+        dx = (GetNoise(x1, y) - GetNoise(x0, y)) / (float)(x1 - x0);
+        dy = (GetNoise(x, y1) - GetNoise(x, y0)) / (float)(y1 - y0);
 
-        return Lerp(xf0, xf1, ys);
+        return GetNoise(x, y);
     }
 
     template <typename FNfloat>
-    float SingleValue(int seed, FNfloat x, FNfloat y, FNfloat z) const
+    float GetNoiseFiniteDifference(FNfloat x, FNfloat y, FNfloat z, float& dx, float& dy, float& dz) const
     {
-        int x0 = FastFloor(x);
-        int y0 = FastFloor(y);
-        int z0 = FastFloor(z);
-
-        float xs = InterpHermite((float)(x - x0));
-        float ys = InterpHermite((float)(y - y0));
-        float zs = InterpHermite((float)(z - z0));
-
-        x0 *= PrimeX;
-        y0 *= PrimeY;
-        z0 *= PrimeZ;
-        int x1 = x0 + PrimeX;
-        int y1 = y0 + PrimeY;
-        int z1 = z0 + PrimeZ;
-
-        float xf00 = Lerp(ValCoord(seed, x0, y0, z0), ValCoord(seed, x1, y0, z0), xs);
-        float xf10 = Lerp(ValCoord(seed, x0, y1, z0), ValCoord(seed, x1, y1, z0), xs);
-        float xf01 = Lerp(ValCoord(seed, x0, y0, z1), ValCoord(seed, x1, y0, z1), xs);
-        float xf11 = Lerp(ValCoord(seed, x0, y1, z1), ValCoord(seed, x1, y1, z1), xs);
+        FNfloat h = (FNfloat)(mFrequency != 0 ? 0.001f / FastAbs(mFrequency) : 0.001f);
 
-        float yf0 = Lerp(xf00, xf10, ys);
-        float yf1 = Lerp(xf01, xf11, ys);
+        FNfloat x0 = x - h, x1 = x + h;
+        FNfloat y0 = y - h, y1 = y + h;
+        FNfloat z0 = z - h, z1 = z + h;
+        dx = (GetNoise(x1, y, z) - GetNoise(x0, y, z)) / (float)(x1 - x0);
+        dy = (GetNoise(x, y1, z) - GetNoise(x, y0, z)) / (float)(y1 - y0);
+        dz = (GetNoise(x, y, z1) - GetNoise(x, y, z0)) / (float)(z1 - z0);
 
-        return Lerp(yf0, yf1, zs);
+        return GetNoise(x, y, z);
     }
 
+    // Chain rule through TransformNoiseCoordinate; the transforms are linear, so this
+    // applies their transposed matrix
 
-    // Domain Warp
-
-    template <typename FNfloat>
-    void DoSingleDomainWarp(int seed, float amp, float freq, FNfloat x, FNfloat y, FNfloat& xr, FNfloat& yr) const
+    void TransformNoiseDerivative(float& dx, float& dy) const
     {
-        switch (mDomainWarpType)
+        switch (mNoiseType)
         {
-        case DomainWarpType_OpenSimplex2:
-            SingleDomainWarpSimplexGradient(seed, amp * 38.283687591552734375f, freq, x, y, xr, yr, false);
-            break;
-        case DomainWarpType_OpenSimplex2Reduced:
-            SingleDomainWarpSimplexGradient(seed, amp * 16.0f, freq, x, y, xr, yr, true);
+        case NoiseType_OpenSimplex2:
+        case NoiseType_OpenSimplex2S:
+            {
+                const float SQRT3 = (float)1.7320508075688772935274463415059;
+                const float F2 = 0.5f * (SQRT3 - 1);
+                float t = (dx + dy) * F2;
+                dx += t;
+                dy += t;
+            }
             break;
-        case DomainWarpType_BasicGrid:
-            SingleDomainWarpBasicGrid(seed, amp, freq, x, y, xr, yr);
+        default:
             break;
         }
+
+        dx *= mFrequency;
+        dy *= mFrequency;
     }
 
-    template <typename FNfloat>
-    void DoSingleDomainWarp(int seed, float amp, float freq, FNfloat x, FNfloat y, FNfloat z, FNfloat& xr, FNfloat& yr, FNfloat& zr) const
+    void TransformNoiseDerivative(float& dx, float& dy, float& dz) const
     {
-        switch (mDomainWarpType)
+        switch (mTransformType3D)
         {
-        case DomainWarpType_OpenSimplex2:
-            SingleDomainWarpOpenSimplex2Gradient(seed, amp * 32.69428253173828125f, freq, x, y, z, xr, yr, zr, false);
+        case TransformType3D_ImproveXYPlanes:
+            {
+                float xy = dx + dy;
+                float s2 = xy * -(float)0.211324865405187;
+                float zr = dz * (float)0.577350269189626;
+                dx += s2 + zr;
+                dy += s2 + zr;
+                dz = zr - xy * (float)0.577350269189626;
+            }
             break;
-        case DomainWarpType_OpenSimplex2Reduced:
-            SingleDomainWarpOpenSimplex2Gradient(seed, amp * 7.71604938271605f, freq, x, y, z, xr, yr, zr, true);
+        case TransformType3D_ImproveXZPlanes:
+            {
+                float xz = dx + dz;
+                float s2 = xz * -(float)0.211324865405187;
+                float yr = dy * (float)0.577350269189626;
+                dx += s2 + yr;
+                dz += s2 + yr;
+                dy = yr - xz * (float)0.577350269189626;
+            }
             break;
-        case DomainWarpType_BasicGrid:
-            SingleDomainWarpBasicGrid(seed, amp, freq, x, y, z, xr, yr, zr);
+        case TransformType3D_DefaultOpenSimplex2:
+            {
+                const float R3 = (float)(2.0 / 3.0);
+                float r = (dx + dy + dz) * R3;
+                dx = r - dx;
+                dy = r - dy;
+                dz = r - dz;
+            }
+            break;
+        default:
             break;
         }
-    }
 
-
-    // Domain Warp Single Wrapper
+        dx *= mFrequency;
+        dy *= mFrequency;
+        dz *= mFrequency;
+    }
 
     template <typename FNfloat>
-    void DomainWarpSingle(FNfloat& x, FNfloat& y) const
+    float GenNoiseSingleDerivative(int seed, FNfloat x, FNfloat y, float& dx, float& dy) const
     {
-        int seed = mSeed;
-        float amp = mDomainWarpAmp * mFractalBounding;
-        float freq = mFrequency;
-
-        FNfloat xs = x;
-        FNfloat ys = y;
-        TransformDomainWarpCoordinate(xs, ys);
-
-        DoSingleDomainWarp(seed, amp, freq, xs, ys, x, y);
+        switch (mNoiseType)
+        {
+        case NoiseType_OpenSimplex2:
+            return SingleSimplexDerivative(seed, x, y, dx, dy);
+        case NoiseType_Perlin:
+            return SinglePerlinDerivative(seed, x, y, dx, dy);
+        default:
+            dx = dy = 0;
+            return GenNoiseSingle(seed, x, y);
+        }
     }
 
     template <typename FNfloat>
-    void DomainWarpSingle(FNfloat& x, FNfloat& y, FNfloat& z) const
+    float GenNoiseSingleDerivative(int seed, FNfloat x, FNfloat y, FNfloat z, float& dx, float& dy, float& dz) const
     {
-        int seed = mSeed;
-        float amp = mDomainWarpAmp * mFractalBounding;
-        float freq = mFrequency;
-
-        FNfloat xs = x;
-        FNfloat ys = y;
-        FNfloat zs = z;
-        TransformDomainWarpCoordinate(xs, ys, zs);
-
-        DoSingleDomainWarp(seed, amp, freq, xs, ys, zs, x, y, z);
+        switch (mNoiseType)
+        {
+        case NoiseType_OpenSimplex2:
+            return SingleOpenSimplex2Derivative(seed, x, y, z, dx, dy, dz);
+        case NoiseType_Perlin:
+            return SinglePerlinDerivative(seed, x, y, z, dx, dy, dz);
+        default:
+            dx = dy = dz = 0;
+            return GenNoiseSingle(seed, x, y, z);
+        }
     }
 
-
-    // Domain Warp Fractal Progressive
+    // FBm as GenFractalFBm. Each octave's derivative is scaled by the lacunarity its
+    // coordinates were; with a weighted strength an octave's amplitude depends on the
+    // octaves before it, so the amplitude carries a gradient too
 
     template <typename FNfloat>
-    void DomainWarpFractalProgressive(FNfloat& x, FNfloat& y) const
+    float GenFractalFBmDerivative(FNfloat x, FNfloat y, float& dx, float& dy) const
     {
         int seed = mSeed;
-        float amp = mDomainWarpAmp * mFractalBounding;
-        float freq = mFrequency;
+        float sum = 0;
+        float amp = mFractalBounding;
+        float ampDx = 0, ampDy = 0;
+        float scale = 1;
+        dx = dy = 0;
 
         for (int i = 0; i < mOctaves; i++)
         {
-            FNfloat xs = x;
-            FNfloat ys = y;
-            TransformDomainWarpCoordinate(xs, ys);
+            float noiseDx, noiseDy;
+            float noise = GenNoiseSingleDerivative(seed++, x, y, noiseDx, noiseDy);
+            noiseDx *= scale;
+            noiseDy *= scale;
 
-            DoSingleDomainWarp(seed, amp, freq, xs, ys, x, y);
+            sum += noise * amp;
+            dx += noiseDx * amp + noise * ampDx;
+            dy += noiseDy * amp + noise * ampDy;
 
-            seed++;
+            float weight = Lerp(1.0f, FastMin(noise + 1, 2) * 0.5f, mWeightedStrength);
+            float weightSlope = noise + 1 < 2 ? 0.5f * mWeightedStrength : 0;
+            ampDx = ampDx * weight + amp * weightSlope * noiseDx;
+            ampDy = ampDy * weight + amp * weightSlope * noiseDy;
+            amp *= weight;
+
+            x *= mLacunarity;
+            y *= mLacunarity;
+            scale *= mLacunarity;
             amp *= mGain;
-            freq *= mLacunarity;
+            ampDx *= mGain;
+            ampDy *= mGain;
         }
+
+        return sum;
     }
 
     template <typename FNfloat>
-    void DomainWarpFractalProgressive(FNfloat& x, FNfloat& y, FNfloat& z) const
+    float GenFractalFBmDerivative(FNfloat x, FNfloat y, FNfloat z, float& dx, float& dy, float& dz) const
     {
         int seed = mSeed;
-        float amp = mDomainWarpAmp * mFractalBounding;
-        float freq = mFrequency;
+        float sum = 0;
+        float amp = mFractalBounding;
+        float ampDx = 0, ampDy = 0, ampDz = 0;
+        float scale = 1;
+        dx = dy = dz = 0;
 
         for (int i = 0; i < mOctaves; i++)
         {
-            FNfloat xs = x;
-            FNfloat ys = y;
-            FNfloat zs = z;
-            TransformDomainWarpCoordinate(xs, ys, zs);
+            float noiseDx, noiseDy, noiseDz;
+            float noise = GenNoiseSingleDerivative(seed++, x, y, z, noiseDx, noiseDy, noiseDz);
+            noiseDx *= scale;
+            noiseDy *= scale;
+            noiseDz *= scale;
 
-            DoSingleDomainWarp(seed, amp, freq, xs, ys, zs, x, y, z);
+            sum += noise * amp;
+            dx += noiseDx * amp + noise * ampDx;
+            dy += noiseDy * amp + noise * ampDy;
+            dz += noiseDz * amp + noise * ampDz;
 
-            seed++;
+            float weight = Lerp(1.0f, (noise + 1) * 0.5f, mWeightedStrength);
+            float weightSlope = 0.5f * mWeightedStrength;
+            ampDx = ampDx * weight + amp * weightSlope * noiseDx;
+            ampDy = ampDy * weight + amp * weightSlope * noiseDy;
+            ampDz = ampDz * weight + amp * weightSlope * noiseDz;
+            amp *= weight;
+
+            x *= mLacunarity;
+            y *= mLacunarity;
+            z *= mLacunarity;
+            scale *= mLacunarity;
             amp *= mGain;
-            freq *= mLacunarity;
+            ampDx *= mGain;
+            ampDy *= mGain;
+            ampDz *= mGain;
         }
-    }
-
 
-    // Domain Warp Fractal Independant
+        return sum;
+    }
 
     template <typename FNfloat>
-    void DomainWarpFractalIndependent(FNfloat& x, FNfloat& y) const
+    float SinglePerlinDerivative(int seed, FNfloat x, FNfloat y, float& dx, float& dy) const
     {
-        FNfloat xs = x;
-        FNfloat ys = y;
-        TransformDomainWarpCoordinate(xs, ys);
-
-        int seed = mSeed;
-        float amp = mDomainWarpAmp * mFractalBounding;
-        float freq = mFrequency;
-
-        for (int i = 0; i < mOctaves; i++)
-        {
-            DoSingleDomainWarp(seed, amp, freq, xs, ys, x, y);
-
-            seed++;
-            amp *= mGain;
-            freq *= mLacunarity;
-        }
-    }
-
-    template <typename FNfloat>
-    void DomainWarpFractalIndependent(FNfloat& x, FNfloat& y, FNfloat& z) const
-    {
-        FNfloat xs = x;
-        FNfloat ys = y;
-        FNfloat zs = z;
-        TransformDomainWarpCoordinate(xs, ys, zs);
-
-        int seed = mSeed;
-        float amp = mDomainWarpAmp * mFractalBounding;
-        float freq = mFrequency;
-
-        for (int i = 0; i < mOctaves; i++)
-        {
-            DoSingleDomainWarp(seed, amp, freq, xs, ys, zs, x, y, z);
-
-            seed++;
-            amp *= mGain;
-            freq *= mLacunarity;
-        }
-    }
-
-
-    // Domain Warp Basic Grid
-
-    template <typename FNfloat>
-    void SingleDomainWarpBasicGrid(int seed, float warpAmp, float frequency, FNfloat x, FNfloat y, FNfloat& xr, FNfloat& yr) const
-    {
-        FNfloat xf = x * frequency;
-        FNfloat yf = y * frequency;
+        int x0 = FastFloor(x);
+        int y0 = FastFloor(y);
 
-        int x0 = FastFloor(xf);
-        int y0 = FastFloor(yf);
+        float xd0 = (float)(x - x0);
+        float yd0 = (float)(y - y0);
+        float xd1 = xd0 - 1;
+        float yd1 = yd0 - 1;
 
-        float xs = InterpHermite((float)(xf - x0));
-        float ys = InterpHermite((float)(yf - y0));
+        float xs = InterpQuintic(xd0);
+        float ys = InterpQuintic(yd0);
+        float xsd = InterpQuinticDerivative(xd0);
+        float ysd = InterpQuinticDerivative(yd0);
 
         x0 *= PrimeX;
         y0 *= PrimeY;
         int x1 = x0 + PrimeX;
         int y1 = y0 + PrimeY;
 
-        int hash0 = Hash(seed, x0, y0) & (255 << 1);
-        int hash1 = Hash(seed, x1, y0) & (255 << 1);
+        float xg00, yg00, xg10, yg10, xg01, yg01, xg11, yg11;
+        GradCoordVector(seed, x0, y0, xg00, yg00);
+        GradCoordVector(seed, x1, y0, xg10, yg10);
+        GradCoordVector(seed, x0, y1, xg01, yg01);
+        GradCoordVector(seed, x1, y1, xg11, yg11);
 
-        float lx0x = Lerp(Lookup<float>::RandVecs2D[hash0], Lookup<float>::RandVecs2D[hash1], xs);
-        float ly0x = Lerp(Lookup<float>::RandVecs2D[hash0 | 1], Lookup<float>::RandVecs2D[hash1 | 1], xs);
+        float v00 = xd0 * xg00 + yd0 * yg00;
+        float v10 = xd1 * xg10 + yd0 * yg10;
+        float v01 = xd0 * xg01 + yd1 * yg01;
+        float v11 = xd1 * xg11 + yd1 * yg11;
 
-        hash0 = Hash(seed, x0, y1) & (255 << 1);
-        hash1 = Hash(seed, x1, y1) & (255 << 1);
+        float xf0 = Lerp(v00, v10, xs);
+        float xf1 = Lerp(v01, v11, xs);
 
-        float lx1x = Lerp(Lookup<float>::RandVecs2D[hash0], Lookup<float>::RandVecs2D[hash1], xs);
-        float ly1x = Lerp(Lookup<float>::RandVecs2D[hash0 | 1], Lookup<float>::RandVecs2D[hash1 | 1], xs);
+        float xf0dx = Lerp(xg00, xg10, xs) + xsd * (v10 - v00);
+        float xf1dx = Lerp(xg01, xg11, xs) + xsd * (v11 - v01);
+        float xf0dy = Lerp(yg00, yg10, xs);
+        float xf1dy = Lerp(yg01, yg11, xs);
 
-        xr += Lerp(lx0x, lx1x, ys) * warpAmp;
-        yr += Lerp(ly0x, ly1x, ys) * warpAmp;
+        dx = Lerp(xf0dx, xf1dx, ys) * 1.4247691104677813f;
+        dy = (Lerp(xf0dy, xf1dy, ys) + ysd * (xf1 - xf0)) * 1.4247691104677813f;
+
+        return Lerp(xf0, xf1, ys) * 1.4247691104677813f;
     }
 
     template <typename FNfloat>
-    void SingleDomainWarpBasicGrid(int seed, float warpAmp, float frequency, FNfloat x, FNfloat y, FNfloat z, FNfloat& xr, FNfloat& yr, FNfloat& zr) const
+    float SinglePerlinDerivative(int seed, FNfloat x, FNfloat y, FNfloat z, float& dx, float& dy, float& dz) const
     {
-        FNfloat xf = x * frequency;
-        FNfloat yf = y * frequency;
-        FNfloat zf = z * frequency;
-
-        int x0 = FastFloor(xf);
-        int y0 = FastFloor(yf);
-        int z0 = FastFloor(zf);
-
-        float xs = InterpHermite((float)(xf - x0));
-        float ys = InterpHermite((float)(yf - y0));
-        float zs = InterpHermite((float)(zf - z0));
-
-        x0 *= PrimeX;
-        y0 *= PrimeY;
-        z0 *= PrimeZ;
-        int x1 = x0 + PrimeX;
-        int y1 = y0 + PrimeY;
-        int z1 = z0 + PrimeZ;
-
-        int hash0 = Hash(seed, x0, y0, z0) & (255 << 2);
-        int hash1 = Hash(seed, x1, y0, z0) & (255 << 2);
-
-        float lx0x = Lerp(Lookup<float>::RandVecs3D[hash0], Lookup<float>::RandVecs3D[hash1], xs);
-        float ly0x = Lerp(Lookup<float>::RandVecs3D[hash0 | 1], Lookup<float>::RandVecs3D[hash1 | 1], xs);
-        float lz0x = Lerp(Lookup<float>::RandVecs3D[hash0 | 2], Lookup<float>::RandVecs3D[hash1 | 2], xs);
-
-        hash0 = Hash(seed, x0, y1, z0) & (255 << 2);
-        hash1 = Hash(seed, x1, y1, z0) & (255 << 2);
-
-        float lx1x = Lerp(Lookup<float>::RandVecs3D[hash0], Lookup<float>::RandVecs3D[hash1], xs);
-        float ly1x = Lerp(Lookup<float>::RandVecs3D[hash0 | 1], Lookup<float>::RandVecs3D[hash1 | 1], xs);
-        float lz1x = Lerp(Lookup<float>::RandVecs3D[hash0 | 2], Lookup<float>::RandVecs3D[hash1 | 2], xs);
+        int x0 = FastFloor(x);
+        int y0 = FastFloor(y);
+        int z0 = FastFloor(z);
 
-        float lx0y = Lerp(lx0x, lx1x, ys);
-        float ly0y = Lerp(ly0x, ly1x, ys);
-        float lz0y = Lerp(lz0x, lz1x, ys);
+        float xd[2], yd[2], zd[2];
+        xd[0] = (float)(x - x0);
+        yd[0] = (float)(y - y0);
+        zd[0] = (float)(z - z0);
+        xd[1] = xd[0] - 1;
+        yd[1] = yd[0] - 1;
+        zd[1] = zd[0] - 1;
+
+        float xs = InterpQuintic(xd[0]);
+        float ys = InterpQuintic(yd[0]);
+        float zs = InterpQuintic(zd[0]);
+        float xsd = InterpQuinticDerivative(xd[0]);
+        float ysd = InterpQuinticDerivative(yd[0]);
+        float zsd = InterpQuinticDerivative(zd[0]);
+
+        int xp[2], yp[2], zp[2];
+        xp[0] = x0 * PrimeX;
+        yp[0] = y0 * PrimeY;
+        zp[0] = z0 * PrimeZ;
+        xp[1] = xp[0] + PrimeX;
+        yp[1] = yp[0] + PrimeY;
+        zp[1] = zp[0] + PrimeZ;
+
+        // the x lerp of each y/z edge with its gradient, indexed [z][y]
+        float xf[2][2], xfdx[2][2], xfdy[2][2], xfdz[2][2];
+        for (int k = 0; k < 2; k++)
+            for (int j = 0; j < 2; j++)
+            {
+                float xg0, yg0, zg0, xg1, yg1, zg1;
+                GradCoordVector(seed, xp[0], yp[j], zp[k], xg0, yg0, zg0);
+                GradCoordVector(seed, xp[1], yp[j], zp[k], xg1, yg1, zg1);
 
-        hash0 = Hash(seed, x0, y0, z1) & (255 << 2);
-        hash1 = Hash(seed, x1, y0, z1) & (255 << 2);
+                float v0 = xd[0] * xg0 + yd[j] * yg0 + zd[k] * zg0;
+                float v1 = xd[1] * xg1 + yd[j] * yg1 + zd[k] * zg1;
 
-        lx0x = Lerp(Lookup<float>::RandVecs3D[hash0], Lookup<float>::RandVecs3D[hash1], xs);
-        ly0x = Lerp(Lookup<float>::RandVecs3D[hash0 | 1], Lookup<float>::RandVecs3D[hash1 | 1], xs);
-        lz0x = Lerp(Lookup<float>::RandVecs3D[hash0 | 2], Lookup<float>::RandVecs3D[hash1 | 2], xs);
+                xf[k][j] = Lerp(v0, v1, xs);
+                xfdx[k][j] = Lerp(xg0, xg1, xs) + xsd * (v1 - v0);
+                xfdy[k][j] = Lerp(yg0, yg1, xs);
+                xfdz[k][j] = Lerp(zg0, zg1, xs);
+            }
 
-        hash0 = Hash(seed, x0, y1, z1) & (255 << 2);
-        hash1 = Hash(seed, x1, y1, z1) & (255 << 2);
+        float yf0 = Lerp(xf[0][0], xf[0][1], ys);
+        float yf1 = Lerp(xf[1][0], xf[1][1], ys);
+        float yf0dx = Lerp(xfdx[0][0], xfdx[0][1], ys);
+        float yf1dx = Lerp(xfdx[1][0], xfdx[1][1], ys);
+        float yf0dy = Lerp(xfdy[0][0], xfdy[0][1], ys) + ysd * (xf[0][1] - xf[0][0]);
+        float yf1dy = Lerp(xfdy[1][0], xfdy[1][1], ys) + ysd * (xf[1][1] - xf[1][0]);
+        float yf0dz = Lerp(xfdz[0][0], xfdz[0][1], ys);
+        float yf1dz = Lerp(xfdz[1][0], xfdz[1][1], ys);
 
-        lx1x = Lerp(Lookup<float>::RandVecs3D[hash0], Lookup<float>::RandVecs3D[hash1], xs);
-        ly1x = Lerp(Lookup<float>::RandVecs3D[hash0 | 1], Lookup<float>::RandVecs3D[hash1 | 1], xs);
-        lz1x = Lerp(Lookup<float>::RandVecs3D[hash0 | 2], Lookup<float>::RandVecs3D[hash1 | 2], xs);
+        dx = Lerp(yf0dx, yf1dx, zs) * 0.964921414852142333984375f;
+        dy = Lerp(yf0dy, yf1dy, zs) * 0.964921414852142333984375f;
+        dz = (Lerp(yf0dz, yf1dz, zs) + zsd * (yf1 - yf0)) * 0.964921414852142333984375f;
 
-        xr += Lerp(lx0y, Lerp(lx0x, lx1x, ys), zs) * warpAmp;
-        yr += Lerp(ly0y, Lerp(ly0x, ly1x, ys), zs) * warpAmp;
-        zr += Lerp(lz0y, Lerp(lz0x, lz1x, ys), zs) * warpAmp;
+        return Lerp(yf0, yf1, zs) * 0.964921414852142333984375f;
     }
 
-
-    // Domain Warp Simplex/OpenSimplex2
+    // Each simplex corner adds a^4 (g.d) with a = r^2 - |d|^2, whose gradient in d is
+    // a^4 g - 8 a^3 (g.d) d
 
     template <typename FNfloat>
-    void SingleDomainWarpSimplexGradient(int seed, float warpAmp, float frequency, FNfloat x, FNfloat y, FNfloat& xr, FNfloat& yr, bool outGradOnly) const
+    float SingleSimplexDerivative(int seed, FNfloat x, FNfloat y, float& dx, float& dy) const
     {
         const float SQRT3 = 1.7320508075688772935274463415059f;
         const float G2 = (3 - SQRT3) / 6;
 
-        x *= frequency;
-        y *= frequency;
-
-        /*
-         * --- Skew moved to TransformNoiseCoordinate method ---
-         * const FNfloat F2 = 0.5f * (SQRT3 - 1);
-         * FNfloat s = (x + y) * F2;
-         * x += s; y += s;
-        */
-
         int i = FastFloor(x);
         int j = FastFloor(y);
         float xi = (float)(x - i);
@@ -2253,100 +3102,88 @@ private:
         i *= PrimeX;
         j *= PrimeY;
 
-        float vx, vy;
-        vx = vy = 0;
+        float n0, n1, n2;
+        float gx = 0, gy = 0;
+        float xg, yg;
 
         float a = 0.5f - x0 * x0 - y0 * y0;
-        if (a > 0)
+        if (a <= 0) n0 = 0;
+        else
         {
-            float aaaa = (a * a) * (a * a);
-            float xo, yo;
-            if (outGradOnly)
-                GradCoordOut(seed, i, j, xo, yo);
-            else
-                GradCoordDual(seed, i, j, x0, y0, xo, yo);
-            vx += aaaa * xo;
-            vy += aaaa * yo;
+            GradCoordVector(seed, i, j, xg, yg);
+            float v = x0 * xg + y0 * yg;
+            float aa = a * a;
+            n0 = (aa * aa) * v;
+            float k = -8 * aa * a * v;
+            gx += aa * aa * xg + k * x0;
+            gy += aa * aa * yg + k * y0;
         }
 
         float c = (float)(2 * (1 - 2 * G2) * (1 / G2 - 2)) * t + ((float)(-2 * (1 - 2 * G2) * (1 - 2 * G2)) + a);
-        if (c > 0)
+        if (c <= 0) n2 = 0;
+        else
         {
             float x2 = x0 + (2 * (float)G2 - 1);
             float y2 = y0 + (2 * (float)G2 - 1);
-            float cccc = (c * c) * (c * c);
-            float xo, yo;
-            if (outGradOnly)
-                GradCoordOut(seed, i + PrimeX, j + PrimeY, xo, yo);
-            else
-                GradCoordDual(seed, i + PrimeX, j + PrimeY, x2, y2, xo, yo);
-            vx += cccc * xo;
-            vy += cccc * yo;
+            GradCoordVector(seed, i + PrimeX, j + PrimeY, xg, yg);
+            float v = x2 * xg + y2 * yg;
+            float cc = c * c;
+            n2 = (cc * cc) * v;
+            float k = -8 * cc * c * v;
+            gx += cc * cc * xg + k * x2;
+            gy += cc * cc * yg + k * y2;
         }
 
+        float x1, y1;
+        int i1, j1;
         if (y0 > x0)
         {
-            float x1 = x0 + (float)G2;
-            float y1 = y0 + ((float)G2 - 1);
-            float b = 0.5f - x1 * x1 - y1 * y1;
-            if (b > 0)
-            {
-                float bbbb = (b * b) * (b * b);
-                float xo, yo;
-                if (outGradOnly)
-                    GradCoordOut(seed, i, j + PrimeY, xo, yo);
-                else
-                    GradCoordDual(seed, i, j + PrimeY, x1, y1, xo, yo);
-                vx += bbbb * xo;
-                vy += bbbb * yo;
-            }
+            x1 = x0 + (float)G2;
+            y1 = y0 + ((float)G2 - 1);
+            i1 = i;
+            j1 = j + PrimeY;
         }
         else
         {
-            float x1 = x0 + ((float)G2 - 1);
-            float y1 = y0 + (float)G2;
-            float b = 0.5f - x1 * x1 - y1 * y1;
-            if (b > 0)
-            {
-                float bbbb = (b * b) * (b * b);
-                float xo, yo;
-                if (outGradOnly)
-                    GradCoordOut(seed, i + PrimeX, j, xo, yo);
-                else
-                    GradCoordDual(seed, i + PrimeX, j, x1, y1, xo, yo);
-                vx += bbbb * xo;
-                vy += bbbb * yo;
-            }
+            x1 = x0 + ((float)G2 - 1);
+            y1 = y0 + (float)G2;
+            i1 = i + PrimeX;
+            j1 = j;
+        }
+        float b = 0.5f - x1 * x1 - y1 * y1;
+        if (b <= 0) n1 = 0;
+        else
+        {
+            GradCoordVector(seed, i1, j1, xg, yg);
+            float v = x1 * xg + y1 * yg;
+            float bb = b * b;
+            n1 = (bb * bb) * v;
+            float k = -8 * bb * b * v;
+            gx += bb * bb * xg + k * x1;
+            gy += bb * bb * yg + k * y1;
         }
 
-        xr += vx * warpAmp;
-        yr += vy * warpAmp;
+        // x0, y0 are the input less (xi + yi) * G2 on both axes
+        float unskew = (gx + gy) * G2;
+        dx = (gx - unskew) * 99.83685446303647f;
+        dy = (gy - unskew) * 99.83685446303647f;
+
+        return (n0 + n1 + n2) * 99.83685446303647f;
     }
 
     template <typename FNfloat>
-    void SingleDomainWarpOpenSimplex2Gradient(int seed, float warpAmp, float frequency, FNfloat x, FNfloat y, FNfloat z, FNfloat& xr, FNfloat& yr, FNfloat& zr, bool outGradOnly) const
+    float SingleOpenSimplex2Derivative(int seed, FNfloat x, FNfloat y, FNfloat z, float& dx, float& dy, float& dz) const
     {
-        x *= frequency;
-        y *= frequency;
-        z *= frequency;
-
-        /*
-         * --- Rotation moved to TransformDomainWarpCoordinate method ---
-         * const FNfloat R3 = (FNfloat)(2.0 / 3.0);
-         * FNfloat r = (x + y + z) * R3; // Rotation, not skew
-         * x = r - x; y = r - y; z = r - z;
-        */
-
         int i = FastRound(x);
         int j = FastRound(y);
         int k = FastRound(z);
-        float x0 = (float)x - i;
-        float y0 = (float)y - j;
-        float z0 = (float)z - k;
+        float x0 = (float)(x - i);
+        float y0 = (float)(y - j);
+        float z0 = (float)(z - k);
 
-        int xNSign = (int)(-x0 - 1.0f) | 1;
-        int yNSign = (int)(-y0 - 1.0f) | 1;
-        int zNSign = (int)(-z0 - 1.0f) | 1;
+        int xNSign = (int)(-1.0f - x0) | 1;
+        int yNSign = (int)(-1.0f - y0) | 1;
+        int zNSign = (int)(-1.0f - z0) | 1;
 
         float ax0 = xNSign * -x0;
         float ay0 = yNSign * -y0;
@@ -2356,23 +3193,23 @@ private:
         j *= PrimeY;
         k *= PrimeZ;
 
-        float vx, vy, vz;
-        vx = vy = vz = 0;
-
+        float value = 0;
+        float gx = 0, gy = 0, gz = 0;
+        float xg, yg, zg;
         float a = (0.6f - x0 * x0) - (y0 * y0 + z0 * z0);
-        for (int l = 0; l < 2; l++)
+
+        for (int l = 0; ; l++)
         {
             if (a > 0)
             {
-                float aaaa = (a * a) * (a * a);
-                float xo, yo, zo;
-                if (outGradOnly)
-                    GradCoordOut(seed, i, j, k, xo, yo, zo);
-                else
-                    GradCoordDual(seed, i, j, k, x0, y0, z0, xo, yo, zo);
-                vx += aaaa * xo;
-                vy += aaaa * yo;
-                vz += aaaa * zo;
+                GradCoordVector(seed, i, j, k, xg, yg, zg);
+                float v = x0 * xg + y0 * yg + z0 * zg;
+                float aa = a * a;
+                value += (aa * aa) * v;
+                float s = -8 * aa * a * v;
+                gx += aa * aa * xg + s * x0;
+                gy += aa * aa * yg + s * y0;
+                gz += aa * aa * zg + s * z0;
             }
 
             float b = a + 1;
@@ -2404,15 +3241,14 @@ private:
 
             if (b > 0)
             {
-                float bbbb = (b * b) * (b * b);
-                float xo, yo, zo;
-                if (outGradOnly)
-                    GradCoordOut(seed, i1, j1, k1, xo, yo, zo);
-                else
-                    GradCoordDual(seed, i1, j1, k1, x1, y1, z1, xo, yo, zo);
-                vx += bbbb * xo;
-                vy += bbbb * yo;
-                vz += bbbb * zo;
+                GradCoordVector(seed, i1, j1, k1, xg, yg, zg);
+                float v = x1 * xg + y1 * yg + z1 * zg;
+                float bb = b * b;
+                value += (bb * bb) * v;
+                float s = -8 * bb * b * v;
+                gx += bb * bb * xg + s * x1;
+                gy += bb * bb * yg + s * y1;
+                gz += bb * bb * zg + s * z1;
             }
 
             if (l == 1) break;
@@ -2435,13 +3271,2593 @@ private:
             yNSign = -yNSign;
             zNSign = -zNSign;
 
-            seed += 1293373;
+            seed = ~seed;
         }
 
-        xr += vx * warpAmp;
-        yr += vy * warpAmp;
-        zr += vz * warpAmp;
+        dx = gx * 32.69428253173828125f;
+        dy = gy * 32.69428253173828125f;
+        dz = gz * 32.69428253173828125f;
+
+        return value * 32.69428253173828125f;
     }
+
+
+    // Value Cubic Noise
+
+    template <typename FNfloat>
+    float SingleValueCubic(int seed, FNfloat x, FNfloat y) const
+    {
+        int x1 = FastFloor(x);
+        int y1 = FastFloor(y);
+
+        float xs = (float)(x - x1);
+        float ys = (float)(y - y1);
+
+        x1 *= PrimeX;
+        y1 *= PrimeY;
+        int x0 = x1 - PrimeX;
+        int y0 = y1 - PrimeY;
+        int x2 = x1 + PrimeX;
+        int y2 = y1 + PrimeY;
+        int x3 = x1 + (int)((long)PrimeX << 1);
+        int y3 = y1 + (int)((long)PrimeY << 1);
+
+        return CubicLerp(
+            CubicLerp(ValCoord(seed, x0, y0), ValCoord(seed, x1, y0), ValCoord(seed, x2, y0), ValCoord(seed, x3, y0),
+                      xs),
+            CubicLerp(ValCoord(seed, x0, y1), ValCoord(seed, x1, y1), ValCoord(seed, x2, y1), ValCoord(seed, x3, y1),
+                      xs),
+            CubicLerp(ValCoord(seed, x0, y2), ValCoord(seed, x1, y2), ValCoord(seed, x2, y2), ValCoord(seed, x3, y2),
+                      xs),
+            CubicLerp(ValCoord(seed, x0, y3), ValCoord(seed, x1, y3), ValCoord(seed, x2, y3), ValCoord(seed, x3, y3),
+                      xs),
+            ys) * (1 / (1.5f * 1.5f));
+    }
+
+    template <typename FNfloat>
+    float SingleValueCubic(int seed, FNfloat x, FNfloat y, FNfloat z) const
+    {
+        int x1 = FastFloor(x);
+        int y1 = FastFloor(y);
+        int z1 = FastFloor(z);
+
+        float xs = (float)(x - x1);
+        float ys = (float)(y - y1);
+        float zs = (float)(z - z1);
+
+        x1 *= PrimeX;
+        y1 *= PrimeY;
+        z1 *= PrimeZ;
+
+        int x0 = x1 - PrimeX;
+        int y0 = y1 - PrimeY;
+        int z0 = z1 - PrimeZ;
+        int x2 = x1 + PrimeX;
+        int y2 = y1 + PrimeY;
+        int z2 = z1 + PrimeZ;
+        int x3 = x1 + (int)((long)PrimeX << 1);
+        int y3 = y1 + (int)((long)PrimeY << 1);
+        int z3 = z1 + (int)((long)PrimeZ << 1);
+
+
+        return CubicLerp(
+            CubicLerp(
+                CubicLerp(ValCoord(seed, x0, y0, z0), ValCoord(seed, x1, y0, z0), ValCoord(seed, x2, y0, z0), ValCoord(seed, x3, y0, z0), xs),
+                CubicLerp(ValCoord(seed, x0, y1, z0), ValCoord(seed, x1, y1, z0), ValCoord(seed, x2, y1, z0), ValCoord(seed, x3, y1, z0), xs),
+                CubicLerp(ValCoord(seed, x0, y2, z0), ValCoord(seed, x1, y2, z0), ValCoord(seed, x2, y2, z0), ValCoord(seed, x3, y2, z0), xs),
+                CubicLerp(ValCoord(seed, x0, y3, z0), ValCoord(seed, x1, y3, z0), ValCoord(seed, x2, y3, z0), ValCoord(seed, x3, y3, z0), xs),
+                ys),
+            CubicLerp(
+                CubicLerp(ValCoord(seed, x0, y0, z1), ValCoord(seed, x1, y0, z1), ValCoord(seed, x2, y0, z1), ValCoord(seed, x3, y0, z1), xs),
+                CubicLerp(ValCoord(seed, x0, y1, z1), ValCoord(seed, x1, y1, z1), ValCoord(seed, x2, y1, z1), ValCoord(seed, x3, y1, z1), xs),
+                CubicLerp(ValCoord(seed, x0, y2, z1), ValCoord(seed, x1, y2, z1), ValCoord(seed, x2, y2, z1), ValCoord(seed, x3, y2, z1), xs),
+                CubicLerp(ValCoord(seed, x0, y3, z1), ValCoord(seed, x1, y3, z1), ValCoord(seed, x2, y3, z1), ValCoord(seed, x3, y3, z1), xs),
+                ys),
+            CubicLerp(
+                CubicLerp(ValCoord(seed, x0, y0, z2), ValCoord(seed, x1, y0, z2), ValCoord(seed, x2, y0, z2), ValCoord(seed, x3, y0, z2), xs),
+                CubicLerp(ValCoord(seed, x0, y1, z2), ValCoord(seed, x1, y1, z2), ValCoord(seed, x2, y1, z2), ValCoord(seed, x3, y1, z2), xs),
+                CubicLerp(ValCoord(seed, x0, y2, z2), ValCoord(seed, x1, y2, z2), ValCoord(seed, x2, y2, z2), ValCoord(seed, x3, y2, z2), xs),
+                CubicLerp(ValCoord(seed, x0, y3, z2), ValCoord(seed, x1, y3, z2), ValCoord(seed, x2, y3, z2), ValCoord(seed, x3, y3, z2), xs),
+                ys),
+            CubicLerp(
+                CubicLerp(ValCoord(seed, x0, y0, z3), ValCoord(seed, x1, y0, z3), ValCoord(seed, x2, y0, z3), ValCoord(seed, x3, y0, z3), xs),
+                CubicLerp(ValCoord(seed, x0, y1, z3), ValCoord(seed, x1, y1, z3), ValCoord(seed, x2, y1, z3), ValCoord(seed, x3, y1, z3), xs),
+                CubicLerp(ValCoord(seed, x0, y2, z3), ValCoord(seed, x1, y2, z3), ValCoord(seed, x2, y2, z3), ValCoord(seed, x3, y2, z3), xs),
+                CubicLerp(ValCoord(seed, x0, y3, z3), ValCoord(seed, x1, y3, z3), ValCoord(seed, x2, y3, z3), ValCoord(seed, x3, y3, z3), xs),
+                ys),
+            zs) * (1 / (1.5f * 1.5f * 1.5f));
+    }
+
+
+    // Value Noise
+
+    template <typename FNfloat>
+    float SingleValue(int seed, FNfloat x, FNfloat y) const
+    {
+        int x0 = FastFloor(x);
+        int y0 = FastFloor(y);
+
+        float xs = InterpHermite((float)(x - x0));
+        float ys = InterpHermite((float)(y - y0));
+
+        x0 *= PrimeX;
+        y0 *= PrimeY;
+        int x1 = x0 + PrimeX;
+        int y1 = y0 + PrimeY;
+
+        float xf0 = Lerp(ValCoord(seed, x0, y0), ValCoord(seed, x1, y0), xs);
+        float xf1 = Lerp(ValCoord(seed, x0, y1), ValCoord(seed, x1, y1), xs);
+
+        return Lerp(xf0, xf1, ys);
+    }
+
+    template <typename FNfloat>
+    float SingleValue(int seed, FNfloat x, FNfloat y, FNfloat z) const
+    {
+        int x0 = FastFloor(x);
+        int y0 = FastFloor(y);
+        int z0 = FastFloor(z);
+
+        float xs = InterpHermite((float)(x - x0));
+        float ys = InterpHermite((float)(y - y0));
+        float zs = InterpHermite((float)(z - z0));
+
+        x0 *= PrimeX;
+        y0 *= PrimeY;
+        z0 *= PrimeZ;
+        int x1 = x0 + PrimeX;
+        int y1 = y0 + PrimeY;
+        int z1 = z0 + PrimeZ;
+
+        float xf00 = Lerp(ValCoord(seed, x0, y0, z0), ValCoord(seed, x1, y0, z0), xs);
+        float xf10 = Lerp(ValCoord(seed, x0, y1, z0), ValCoord(seed, x1, y1, z0), xs);
+        float xf01 = Lerp(ValCoord(seed, x0, y0, z1), ValCoord(seed, x1, y0, z1), xs);
+        float xf11 = Lerp(ValCoord(seed, x0, y1, z1), ValCoord(seed, x1, y1, z1), xs);
+
+        float yf0 = Lerp(xf00, xf10, ys);
+        float yf1 = Lerp(xf01, xf11, ys);
+
+        return Lerp(yf0, yf1, zs);
+    }
+
+
+    // Lattice-coherent batch Perlin/Value/ValueCubic. Neighbouring samples mostly fall in
+    // the same lattice cell, so the corner gradients or values are kept from the previous
+    // sample and only rehashed when the cell changes. Stepping one cell along x keeps the
+    // shared corners in 2D. The interpolation is written as in the Single functions, so results
+    // agree with them under the -ffp-contract=off requirement at the top of this file.
+
+    void SinglePerlinCoherent(int seed, const float* xs, const float* ys, float* out, int count) const
+    {
+        int cellX = 0;
+        int cellY = 0;
+        bool cached = false;
+
+        // corners (x0, y0), (x1, y0), (x0, y1), (x1, y1)
+        float xg[4] = {}, yg[4] = {};
+
+        for (int i = 0; i < count; i++)
+        {
+            int x0 = FastFloor(xs[i]);
+            int y0 = FastFloor(ys[i]);
+
+            if (!cached || x0 != cellX || y0 != cellY)
+            {
+                int xPrimed = x0 * PrimeX;
+                int yPrimed = y0 * PrimeY;
+
+                if (cached && y0 == cellY && x0 == cellX + 1)
+                {
+                    xg[0] = xg[1]; yg[0] = yg[1];
+                    xg[2] = xg[3]; yg[2] = yg[3];
+                }
+                else
+                {
+                    GradCoordVector(seed, xPrimed, yPrimed, xg[0], yg[0]);
+                    GradCoordVector(seed, xPrimed, yPrimed + PrimeY, xg[2], yg[2]);
+                }
+                GradCoordVector(seed, xPrimed + PrimeX, yPrimed, xg[1], yg[1]);
+                GradCoordVector(seed, xPrimed + PrimeX, yPrimed + PrimeY, xg[3], yg[3]);
+
+                cellX = x0;
+                cellY = y0;
+                cached = true;
+            }
+
+            float xd0 = (float)(xs[i] - x0);
+            float yd0 = (float)(ys[i] - y0);
+            float xd1 = xd0 - 1;
+            float yd1 = yd0 - 1;
+
+            float xs0 = InterpQuintic(xd0);
+            float ys0 = InterpQuintic(yd0);
+
+            float xf0 = Lerp(xd0 * xg[0] + yd0 * yg[0], xd1 * xg[1] + yd0 * yg[1], xs0);
+            float xf1 = Lerp(xd0 * xg[2] + yd1 * yg[2], xd1 * xg[3] + yd1 * yg[3], xs0);
+
+            out[i] = Lerp(xf0, xf1, ys0) * 1.4247691104677813f;
+        }
+    }
+
+    void SinglePerlinCoherent(int seed, const float* xs, const float* ys, const float* zs, float* out, int count) const
+    {
+        int cellX = 0;
+        int cellY = 0;
+        int cellZ = 0;
+        bool cached = false;
+
+        // corner c is at (x0 + (c & 1), y0 + ((c >> 1) & 1), z0 + (c >> 2))
+        float xg[8] = {}, yg[8] = {}, zg[8] = {};
+
+        for (int i = 0; i < count; i++)
+        {
+            int x0 = FastFloor(xs[i]);
+            int y0 = FastFloor(ys[i]);
+            int z0 = FastFloor(zs[i]);
+
+            if (!cached || x0 != cellX || y0 != cellY || z0 != cellZ)
+            {
+                int xPrimed = x0 * PrimeX;
+                int yPrimed = y0 * PrimeY;
+                int zPrimed = z0 * PrimeZ;
+
+                for (int c = 0; c < 8; c++)
+                    GradCoordVector(seed, c & 1 ? xPrimed + PrimeX : xPrimed, c & 2 ? yPrimed + PrimeY : yPrimed,
+                                    c & 4 ? zPrimed + PrimeZ : zPrimed, xg[c], yg[c], zg[c]);
+
+                cellX = x0;
+                cellY = y0;
+                cellZ = z0;
+                cached = true;
+            }
+
+            float xd0 = (float)(xs[i] - x0);
+            float yd0 = (float)(ys[i] - y0);
+            float zd0 = (float)(zs[i] - z0);
+            float xd1 = xd0 - 1;
+            float yd1 = yd0 - 1;
+            float zd1 = zd0 - 1;
+
+            float xs0 = InterpQuintic(xd0);
+            float ys0 = InterpQuintic(yd0);
+            float zs0 = InterpQuintic(zd0);
+
+            float xf00 = Lerp(xd0 * xg[0] + yd0 * yg[0] + zd0 * zg[0], xd1 * xg[1] + yd0 * yg[1] + zd0 * zg[1], xs0);
+            float xf10 = Lerp(xd0 * xg[2] + yd1 * yg[2] + zd0 * zg[2], xd1 * xg[3] + yd1 * yg[3] + zd0 * zg[3], xs0);
+            float xf01 = Lerp(xd0 * xg[4] + yd0 * yg[4] + zd1 * zg[4], xd1 * xg[5] + yd0 * yg[5] + zd1 * zg[5], xs0);
+            float xf11 = Lerp(xd0 * xg[6] + yd1 * yg[6] + zd1 * zg[6], xd1 * xg[7] + yd1 * yg[7] + zd1 * zg[7], xs0);
+
+            float yf0 = Lerp(xf00, xf10, ys0);
+            float yf1 = Lerp(xf01, xf11, ys0);
+
+            out[i] = Lerp(yf0, yf1, zs0) * 0.964921414852142333984375f;
+        }
+    }
+
+    void SingleValueCoherent(int seed, const float* xs, const float* ys, float* out, int count) const
+    {
+        int cellX = 0;
+        int cellY = 0;
+        bool cached = false;
+
+        // corners (x0, y0), (x1, y0), (x0, y1), (x1, y1)
+        float v[4] = {};
+
+        for (int i = 0; i < count; i++)
+        {
+            int x0 = FastFloor(xs[i]);
+            int y0 = FastFloor(ys[i]);
+
+            if (!cached || x0 != cellX || y0 != cellY)
+            {
+                int xPrimed = x0 * PrimeX;
+                int yPrimed = y0 * PrimeY;
+
+                if (cached && y0 == cellY && x0 == cellX + 1)
+                {
+                    v[0] = v[1];
+                    v[2] = v[3];
+                }
+                else
+                {
+                    v[0] = ValCoord(seed, xPrimed, yPrimed);
+                    v[2] = ValCoord(seed, xPrimed, yPrimed + PrimeY);
+                }
+                v[1] = ValCoord(seed, xPrimed + PrimeX, yPrimed);
+                v[3] = ValCoord(seed, xPrimed + PrimeX, yPrimed + PrimeY);
+
+                cellX = x0;
+                cellY = y0;
+                cached = true;
+            }
+
+            float xs0 = InterpHermite((float)(xs[i] - x0));
+            float ys0 = InterpHermite((float)(ys[i] - y0));
+
+            float xf0 = Lerp(v[0], v[1], xs0);
+            float xf1 = Lerp(v[2], v[3], xs0);
+
+            out[i] = Lerp(xf0, xf1, ys0);
+        }
+    }
+
+    void SingleValueCoherent(int seed, const float* xs, const float* ys, const float* zs, float* out, int count) const
+    {
+        int cellX = 0;
+        int cellY = 0;
+        int cellZ = 0;
+        bool cached = false;
+
+        // corner c is at (x0 + (c & 1), y0 + ((c >> 1) & 1), z0 + (c >> 2))
+        float v[8] = {};
+
+        for (int i = 0; i < count; i++)
+        {
+            int x0 = FastFloor(xs[i]);
+            int y0 = FastFloor(ys[i]);
+            int z0 = FastFloor(zs[i]);
+
+            if (!cached || x0 != cellX || y0 != cellY || z0 != cellZ)
+            {
+                int xPrimed = x0 * PrimeX;
+                int yPrimed = y0 * PrimeY;
+                int zPrimed = z0 * PrimeZ;
+
+                for (int c = 0; c < 8; c++)
+                    v[c] = ValCoord(seed, c & 1 ? xPrimed + PrimeX : xPrimed, c & 2 ? yPrimed + PrimeY : yPrimed,
+                                    c & 4 ? zPrimed + PrimeZ : zPrimed);
+
+                cellX = x0;
+                cellY = y0;
+                cellZ = z0;
+                cached = true;
+            }
+
+            float xs0 = InterpHermite((float)(xs[i] - x0));
+            float ys0 = InterpHermite((float)(ys[i] - y0));
+            float zs0 = InterpHermite((float)(zs[i] - z0));
+
+            float xf00 = Lerp(v[0], v[1], xs0);
+            float xf10 = Lerp(v[2], v[3], xs0);
+            float xf01 = Lerp(v[4], v[5], xs0);
+            float xf11 = Lerp(v[6], v[7], xs0);
+
+            float yf0 = Lerp(xf00, xf10, ys0);
+            float yf1 = Lerp(xf01, xf11, ys0);
+
+            out[i] = Lerp(yf0, yf1, zs0);
+        }
+    }
+
+    // the four primed coordinates around a cell, from the primed coordinate of its low corner
+    static void ValueCubicPrimes(int primed, int prime, int* out)
+    {
+        out[0] = primed - prime;
+        out[1] = primed;
+        out[2] = primed + prime;
+        out[3] = primed + (int)((long)prime << 1);
+    }
+
+    void SingleValueCubicCoherent(int seed, const float* xs, const float* ys, float* out, int count) const
+    {
+        int cellX = 0;
+        int cellY = 0;
+        bool cached = false;
+
+        // v[row][column], the 4x4 points from (x1 - 1, y1 - 1)
+        float v[4][4] = {};
+
+        for (int i = 0; i < count; i++)
+        {
+            int x1 = FastFloor(xs[i]);
+            int y1 = FastFloor(ys[i]);
+
+            if (!cached || x1 != cellX || y1 != cellY)
+            {
+                int xPrimed[4], yPrimed[4];
+                ValueCubicPrimes(x1 * PrimeX, PrimeX, xPrimed);
+                ValueCubicPrimes(y1 * PrimeY, PrimeY, yPrimed);
+                int first = 0;
+
+                if (cached && y1 == cellY && x1 == cellX + 1)
+                {
+                    for (int r = 0; r < 4; r++)
+                        for (int c = 0; c < 3; c++)
+                            v[r][c] = v[r][c + 1];
+                    first = 3;
+                }
+
+                for (int r = 0; r < 4; r++)
+                    for (int c = first; c < 4; c++)
+                        v[r][c] = ValCoord(seed, xPrimed[c], yPrimed[r]);
+
+                cellX = x1;
+                cellY = y1;
+                cached = true;
+            }
+
+            float xs0 = (float)(xs[i] - x1);
+            float ys0 = (float)(ys[i] - y1);
+
+            out[i] = CubicLerp(
+                CubicLerp(v[0][0], v[0][1], v[0][2], v[0][3], xs0),
+                CubicLerp(v[1][0], v[1][1], v[1][2], v[1][3], xs0),
+                CubicLerp(v[2][0], v[2][1], v[2][2], v[2][3], xs0),
+                CubicLerp(v[3][0], v[3][1], v[3][2], v[3][3], xs0),
+                ys0) * (1 / (1.5f * 1.5f));
+        }
+    }
+
+    void SingleValueCubicCoherent(int seed, const float* xs, const float* ys, const float* zs, float* out, int count) const
+    {
+        int cellX = 0;
+        int cellY = 0;
+        int cellZ = 0;
+        bool cached = false;
+
+        // v[layer][row][column], the 4x4x4 points from (x1 - 1, y1 - 1, z1 - 1)
+        float v[4][4][4] = {};
+
+        for (int i = 0; i < count; i++)
+        {
+            int x1 = FastFloor(xs[i]);
+            int y1 = FastFloor(ys[i]);
+            int z1 = FastFloor(zs[i]);
+
+            if (!cached || x1 != cellX || y1 != cellY || z1 != cellZ)
+            {
+                int xPrimed[4], yPrimed[4], zPrimed[4];
+                ValueCubicPrimes(x1 * PrimeX, PrimeX, xPrimed);
+                ValueCubicPrimes(y1 * PrimeY, PrimeY, yPrimed);
+                ValueCubicPrimes(z1 * PrimeZ, PrimeZ, zPrimed);
+
+                for (int l = 0; l < 4; l++)
+                    for (int r = 0; r < 4; r++)
+                        for (int c = 0; c < 4; c++)
+                            v[l][r][c] = ValCoord(seed, xPrimed[c], yPrimed[r], zPrimed[l]);
+
+                cellX = x1;
+                cellY = y1;
+                cellZ = z1;
+                cached = true;
+            }
+
+            float xs0 = (float)(xs[i] - x1);
+            float ys0 = (float)(ys[i] - y1);
+            float zs0 = (float)(zs[i] - z1);
+
+            float layers[4];
+            for (int l = 0; l < 4; l++)
+                layers[l] = CubicLerp(
+                    CubicLerp(v[l][0][0], v[l][0][1], v[l][0][2], v[l][0][3], xs0),
+                    CubicLerp(v[l][1][0], v[l][1][1], v[l][1][2], v[l][1][3], xs0),
+                    CubicLerp(v[l][2][0], v[l][2][1], v[l][2][2], v[l][2][3], xs0),
+                    CubicLerp(v[l][3][0], v[l][3][1], v[l][3][2], v[l][3][3], xs0),
+                    ys0);
+
+            out[i] = CubicLerp(layers[0], layers[1], layers[2], layers[3], zs0) * (1 / (1.5f * 1.5f * 1.5f));
+        }
+    }
+
+
+    // Cellular tile batch, 2D. Each cell's feature point (hash and jittered offset) is kept
+    // for the window of cells around the previous sample and only hashed again when it
+    // enters the window, so a run of samples shares one set of lookups. When only the
+    // closest point is returned and the jitter is small enough that it cannot lie outside
+    // the 2x2 cells around the sample, only those are searched.
+
+    void SingleCellularBlock(int seed, const float* xs, const float* ys, float* out, int count) const
+    {
+        // With the sample u and v from the nearest lattice lines, a cell outside the 2x2
+        // is at least 1 + u - J away on one axis while the nearest inside is within u + J
+        // and v + J, v <= 0.5. That leaves the closest point inside for J < 0.23 measured
+        // as Euclidean (J^2 + 3J - 0.75 < 0), J < 0.20 as hybrid (J^2 + 6J - 1.25 < 0) and
+        // J < 1/6 as Manhattan; the limits keep a margin for rounding.
+        float jitter = FastAbs(0.43701595f * mCellularJitterModifier);
+        bool closestOnly = mCellularReturnType == CellularReturnType_CellValue || mCellularReturnType == CellularReturnType_Distance;
+
+        switch (mCellularDistanceFunction)
+        {
+        default:
+        case CellularDistanceFunction_Euclidean:
+        case CellularDistanceFunction_EuclideanSq:
+            if (closestOnly && jitter <= 0.18f)
+                SingleCellularTile<CellularDistanceFunction_EuclideanSq, 2>(seed, xs, ys, out, count);
+            else
+                SingleCellularTile<CellularDistanceFunction_EuclideanSq, 3>(seed, xs, ys, out, count);
+            break;
+        case CellularDistanceFunction_Manhattan:
+            if (closestOnly && jitter <= 0.15f)
+                SingleCellularTile<CellularDistanceFunction_Manhattan, 2>(seed, xs, ys, out, count);
+            else
+                SingleCellularTile<CellularDistanceFunction_Manhattan, 3>(seed, xs, ys, out, count);
+            break;
+        case CellularDistanceFunction_Hybrid:
+            if (closestOnly && jitter <= 0.18f)
+                SingleCellularTile<CellularDistanceFunction_Hybrid, 2>(seed, xs, ys, out, count);
+            else
+                SingleCellularTile<CellularDistanceFunction_Hybrid, 3>(seed, xs, ys, out, count);
+            break;
+        }
+    }
+
+    template <CellularDistanceFunction Distance>
+    static float CellularDistance(float vecX, float vecY)
+    {
+        switch (Distance)
+        {
+        default:
+            return vecX * vecX + vecY * vecY;
+        case CellularDistanceFunction_Manhattan:
+            return FastAbs(vecX) + FastAbs(vecY);
+        case CellularDistanceFunction_Hybrid:
+            return (FastAbs(vecX) + FastAbs(vecY)) + (vecX * vecX + vecY * vecY);
+        }
+    }
+
+    // Searches a Size x Size window of cells: the 3x3 around the nearest cell like
+    // SingleCellular, or the 2x2 whose corner cell contains the sample
+    template <CellularDistanceFunction Distance, int Size>
+    void SingleCellularTile(int seed, const float* xs, const float* ys, float* out, int count) const
+    {
+        float cellularJitter = 0.43701595f * mCellularJitterModifier;
+
+        int cellX = 0;
+        int cellY = 0;
+        bool cached = false;
+
+        // [column][row] from the window's first cell
+        int hashes[Size][Size] = {};
+        float jitterX[Size][Size] = {};
+        float jitterY[Size][Size] = {};
+
+        for (int i = 0; i < count; i++)
+        {
+            float x = xs[i];
+            float y = ys[i];
+            int firstX = Size == 3 ? FastRound(x) - 1 : FastFloor(x);
+            int firstY = Size == 3 ? FastRound(y) - 1 : FastFloor(y);
+
+            if (!cached || firstX != cellX || firstY != cellY)
+            {
+                int firstColumn = 0;
+
+                if (cached && firstY == cellY && firstX == cellX + 1)
+                {
+                    for (int c = 0; c + 1 < Size; c++)
+                        for (int r = 0; r < Size; r++)
+                        {
+                            hashes[c][r] = hashes[c + 1][r];
+                            jitterX[c][r] = jitterX[c + 1][r];
+                            jitterY[c][r] = jitterY[c + 1][r];
+                        }
+                    firstColumn = Size - 1;
+                }
+
+                int xPrimed = firstX * PrimeX;
+
+                for (int c = 0; c < Size; c++, xPrimed += PrimeX)
+                {
+                    if (c < firstColumn)
+                        continue;
+
+                    int yPrimed = firstY * PrimeY;
+
+                    for (int r = 0; r < Size; r++, yPrimed += PrimeY)
+                    {
+                        int hash = Hash(seed, xPrimed, yPrimed);
+                        int idx = hash & (255 << 1);
+
+                        hashes[c][r] = hash;
+                        jitterX[c][r] = Lookup<float>::RandVecs2D[idx] * cellularJitter;
+                        jitterY[c][r] = Lookup<float>::RandVecs2D[idx | 1] * cellularJitter;
+                    }
+                }
+
+                cellX = firstX;
+                cellY = firstY;
+                cached = true;
+            }
+
+            float distance0 = 1e10f;
+            float distance1 = 1e10f;
+            int closestHash = 0;
+
+            for (int c = 0; c < Size; c++)
+            {
+                for (int r = 0; r < Size; r++)
+                {
+                    float vecX = (float)(firstX + c - x) + jitterX[c][r];
+                    float vecY = (float)(firstY + r - y) + jitterY[c][r];
+
+                    float newDistance = CellularDistance<Distance>(vecX, vecY);
+
+                    distance1 = FastMax(FastMin(distance1, newDistance), distance0);
+                    if (newDistance < distance0)
+                    {
+                        distance0 = newDistance;
+                        closestHash = hashes[c][r];
+                    }
+                }
+            }
+
+            out[i] = CellularReturn(distance0, distance1, closestHash);
+        }
+    }
+
+
+    // Batch Perlin/Simplex, vectorized when available with a scalar tail
+
+    void SinglePerlinBlock(int seed, const float* xs, const float* ys, float* out, int count) const
+    {
+        int i = 0;
+#ifdef FNL_SIMD_X86
+        switch (mSimdLevel)
+        {
+        case SimdLevel_AVX2:
+            i = SinglePerlinAVX2(seed, xs, ys, out, count);
+            break;
+        case SimdLevel_SSE41:
+            i = SinglePerlinSSE41(seed, xs, ys, out, count);
+            break;
+        default:
+            break;
+        }
+#endif
+        SinglePerlinCoherent(seed, xs + i, ys + i, out + i, count - i);
+    }
+
+    void SinglePerlinBlock(int seed, const float* xs, const float* ys, const float* zs, float* out, int count) const
+    {
+        int i = 0;
+#ifdef FNL_SIMD_X86
+        switch (mSimdLevel)
+        {
+        case SimdLevel_AVX2:
+            i = SinglePerlinAVX2(seed, xs, ys, zs, out, count);
+            break;
+        case SimdLevel_SSE41:
+            i = SinglePerlinSSE41(seed, xs, ys, zs, out, count);
+            break;
+        default:
+            break;
+        }
+#endif
+        SinglePerlinCoherent(seed, xs + i, ys + i, zs + i, out + i, count - i);
+    }
+
+    void SingleSimplexBlock(int seed, const float* xs, const float* ys, float* out, int count) const
+    {
+        int i = 0;
+#ifdef FNL_SIMD_X86
+        switch (mSimdLevel)
+        {
+        case SimdLevel_AVX2:
+            i = SingleSimplexAVX2(seed, xs, ys, out, count);
+            break;
+        case SimdLevel_SSE41:
+            i = SingleSimplexSSE41(seed, xs, ys, out, count);
+            break;
+        default:
+            break;
+        }
+#endif
+        for (; i < count; i++) out[i] = SingleSimplex(seed, xs[i], ys[i]);
+    }
+
+    void SinglePerlinMultiBlock(const int* seeds, int fields, const float* xs, const float* ys, float* const* out, int count) const
+    {
+        int i = 0;
+#ifdef FNL_SIMD_X86
+        switch (mSimdLevel)
+        {
+        case SimdLevel_AVX2:
+            i = SinglePerlinMultiAVX2(seeds, fields, xs, ys, out, count);
+            break;
+        case SimdLevel_SSE41:
+            i = SinglePerlinMultiSSE41(seeds, fields, xs, ys, out, count);
+            break;
+        default:
+            break;
+        }
+#endif
+        for (int f = 0; f < fields; f++) SinglePerlinCoherent(seeds[f], xs + i, ys + i, out[f] + i, count - i);
+    }
+
+    void SinglePerlinMultiBlock(const int* seeds, int fields, const float* xs, const float* ys, const float* zs, float* const* out, int count) const
+    {
+        int i = 0;
+#ifdef FNL_SIMD_X86
+        switch (mSimdLevel)
+        {
+        case SimdLevel_AVX2:
+            i = SinglePerlinMultiAVX2(seeds, fields, xs, ys, zs, out, count);
+            break;
+        case SimdLevel_SSE41:
+            i = SinglePerlinMultiSSE41(seeds, fields, xs, ys, zs, out, count);
+            break;
+        default:
+            break;
+        }
+#endif
+        for (int f = 0; f < fields; f++) SinglePerlinCoherent(seeds[f], xs + i, ys + i, zs + i, out[f] + i, count - i);
+    }
+
+    void SingleSimplexMultiBlock(const int* seeds, int fields, const float* xs, const float* ys, float* const* out, int count) const
+    {
+        int i = 0;
+#ifdef FNL_SIMD_X86
+        switch (mSimdLevel)
+        {
+        case SimdLevel_AVX2:
+            i = SingleSimplexMultiAVX2(seeds, fields, xs, ys, out, count);
+            break;
+        case SimdLevel_SSE41:
+            i = SingleSimplexMultiSSE41(seeds, fields, xs, ys, out, count);
+            break;
+        default:
+            break;
+        }
+#endif
+        for (int f = 0; f < fields; f++)
+        {
+            for (int j = i; j < count; j++) out[f][j] = SingleSimplex(seeds[f], xs[j], ys[j]);
+        }
+    }
+
+#ifdef FNL_SIMD_X86
+
+    // SIMD helpers, each mirrors the scalar function of the same name lane for lane
+    // so the kernels below do the same operations as SinglePerlin/SingleSimplex
+
+    FNL_TARGET_SSE41 static __m128i FastFloor(__m128 f)
+    {
+        return _mm_add_epi32(_mm_cvttps_epi32(f), _mm_castps_si128(_mm_cmplt_ps(f, _mm_setzero_ps())));
+    }
+
+    FNL_TARGET_SSE41 static __m128 Lerp(__m128 a, __m128 b, __m128 t)
+    {
+        return _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)));
+    }
+
+    FNL_TARGET_SSE41 static __m128 InterpQuintic(__m128 t)
+    {
+        __m128 ttt = _mm_mul_ps(_mm_mul_ps(t, t), t);
+        __m128 inner = _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6)), _mm_set1_ps(15));
+        return _mm_mul_ps(ttt, _mm_add_ps(_mm_mul_ps(t, inner), _mm_set1_ps(10)));
+    }
+
+    FNL_TARGET_SSE41 static __m128i Hash(__m128i seed, __m128i xPrimed, __m128i yPrimed)
+    {
+        __m128i hash = _mm_xor_si128(_mm_xor_si128(seed, xPrimed), yPrimed);
+        return _mm_mullo_epi32(hash, _mm_set1_epi32(0x27d4eb2d));
+    }
+
+    FNL_TARGET_SSE41 static __m128i Hash(__m128i seed, __m128i xPrimed, __m128i yPrimed, __m128i zPrimed)
+    {
+        __m128i hash = _mm_xor_si128(_mm_xor_si128(_mm_xor_si128(seed, xPrimed), yPrimed), zPrimed);
+        return _mm_mullo_epi32(hash, _mm_set1_epi32(0x27d4eb2d));
+    }
+
+    FNL_TARGET_SSE41 static __m128 Gather(const float* table, __m128i index, int offset)
+    {
+        alignas(16) int idx[4];
+        _mm_store_si128((__m128i*)idx, index);
+        return _mm_setr_ps(table[idx[0] | offset], table[idx[1] | offset], table[idx[2] | offset], table[idx[3] | offset]);
+    }
+
+    FNL_TARGET_SSE41 static __m128 GradCoord(__m128i seed, __m128i xPrimed, __m128i yPrimed, __m128 xd, __m128 yd)
+    {
+        __m128i hash = Hash(seed, xPrimed, yPrimed);
+        hash = _mm_xor_si128(hash, _mm_srai_epi32(hash, 15));
+        hash = _mm_and_si128(hash, _mm_set1_epi32(127 << 1));
+
+        __m128 xg = Gather(Lookup<float>::Gradients2D, hash, 0);
+        __m128 yg = Gather(Lookup<float>::Gradients2D, hash, 1);
+
+        return _mm_add_ps(_mm_mul_ps(xd, xg), _mm_mul_ps(yd, yg));
+    }
+
+    FNL_TARGET_SSE41 static __m128 GradCoord(__m128i seed, __m128i xPrimed, __m128i yPrimed, __m128i zPrimed, __m128 xd, __m128 yd, __m128 zd)
+    {
+        __m128i hash = Hash(seed, xPrimed, yPrimed, zPrimed);
+        hash = _mm_xor_si128(hash, _mm_srai_epi32(hash, 15));
+        hash = _mm_and_si128(hash, _mm_set1_epi32(63 << 2));
+
+        __m128 xg = Gather(Lookup<float>::Gradients3D, hash, 0);
+        __m128 yg = Gather(Lookup<float>::Gradients3D, hash, 1);
+        __m128 zg = Gather(Lookup<float>::Gradients3D, hash, 2);
+
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(xd, xg), _mm_mul_ps(yd, yg)), _mm_mul_ps(zd, zg));
+    }
+
+    FNL_TARGET_AVX2 static __m256i FastFloor(__m256 f)
+    {
+        return _mm256_add_epi32(_mm256_cvttps_epi32(f), _mm256_castps_si256(_mm256_cmp_ps(f, _mm256_setzero_ps(), _CMP_LT_OQ)));
+    }
+
+    FNL_TARGET_AVX2 static __m256 Lerp(__m256 a, __m256 b, __m256 t)
+    {
+        return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+    }
+
+    FNL_TARGET_AVX2 static __m256 InterpQuintic(__m256 t)
+    {
+        __m256 ttt = _mm256_mul_ps(_mm256_mul_ps(t, t), t);
+        __m256 inner = _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6)), _mm256_set1_ps(15));
+        return _mm256_mul_ps(ttt, _mm256_add_ps(_mm256_mul_ps(t, inner), _mm256_set1_ps(10)));
+    }
+
+    FNL_TARGET_AVX2 static __m256i Hash(__m256i seed, __m256i xPrimed, __m256i yPrimed)
+    {
+        __m256i hash = _mm256_xor_si256(_mm256_xor_si256(seed, xPrimed), yPrimed);
+        return _mm256_mullo_epi32(hash, _mm256_set1_epi32(0x27d4eb2d));
+    }
+
+    FNL_TARGET_AVX2 static __m256i Hash(__m256i seed, __m256i xPrimed, __m256i yPrimed, __m256i zPrimed)
+    {
+        __m256i hash = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(seed, xPrimed), yPrimed), zPrimed);
+        return _mm256_mullo_epi32(hash, _mm256_set1_epi32(0x27d4eb2d));
+    }
+
+    FNL_TARGET_AVX2 static __m256 GradCoord(__m256i seed, __m256i xPrimed, __m256i yPrimed, __m256 xd, __m256 yd)
+    {
+        __m256i hash = Hash(seed, xPrimed, yPrimed);
+        hash = _mm256_xor_si256(hash, _mm256_srai_epi32(hash, 15));
+        hash = _mm256_and_si256(hash, _mm256_set1_epi32(127 << 1));
+
+        __m256 xg = _mm256_i32gather_ps(Lookup<float>::Gradients2D, hash, 4);
+        __m256 yg = _mm256_i32gather_ps(Lookup<float>::Gradients2D + 1, hash, 4);
+
+        return _mm256_add_ps(_mm256_mul_ps(xd, xg), _mm256_mul_ps(yd, yg));
+    }
+
+    FNL_TARGET_AVX2 static __m256 GradCoord(__m256i seed, __m256i xPrimed, __m256i yPrimed, __m256i zPrimed, __m256 xd, __m256 yd, __m256 zd)
+    {
+        __m256i hash = Hash(seed, xPrimed, yPrimed, zPrimed);
+        hash = _mm256_xor_si256(hash, _mm256_srai_epi32(hash, 15));
+        hash = _mm256_and_si256(hash, _mm256_set1_epi32(63 << 2));
+
+        __m256 xg = _mm256_i32gather_ps(Lookup<float>::Gradients3D, hash, 4);
+        __m256 yg = _mm256_i32gather_ps(Lookup<float>::Gradients3D + 1, hash, 4);
+        __m256 zg = _mm256_i32gather_ps(Lookup<float>::Gradients3D + 2, hash, 4);
+
+        return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(xd, xg), _mm256_mul_ps(yd, yg)), _mm256_mul_ps(zd, zg));
+    }
+
+
+    // SIMD Perlin, returns the number of samples processed, the caller finishes the tail
+
+    FNL_TARGET_SSE41 static int SinglePerlinSSE41(int seed, const float* xs, const float* ys, float* out, int count)
+    {
+        const __m128i vSeed = _mm_set1_epi32(seed);
+        const __m128i vPrimeX = _mm_set1_epi32(PrimeX);
+        const __m128i vPrimeY = _mm_set1_epi32(PrimeY);
+        const __m128 vOne = _mm_set1_ps(1);
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(xs + i);
+            __m128 y = _mm_loadu_ps(ys + i);
+
+            __m128i x0 = FastFloor(x);
+            __m128i y0 = FastFloor(y);
+
+            __m128 xd0 = _mm_sub_ps(x, _mm_cvtepi32_ps(x0));
+            __m128 yd0 = _mm_sub_ps(y, _mm_cvtepi32_ps(y0));
+            __m128 xd1 = _mm_sub_ps(xd0, vOne);
+            __m128 yd1 = _mm_sub_ps(yd0, vOne);
+
+            __m128 xs0 = InterpQuintic(xd0);
+            __m128 ys0 = InterpQuintic(yd0);
+
+            x0 = _mm_mullo_epi32(x0, vPrimeX);
+            y0 = _mm_mullo_epi32(y0, vPrimeY);
+            __m128i x1 = _mm_add_epi32(x0, vPrimeX);
+            __m128i y1 = _mm_add_epi32(y0, vPrimeY);
+
+            __m128 xf0 = Lerp(GradCoord(vSeed, x0, y0, xd0, yd0), GradCoord(vSeed, x1, y0, xd1, yd0), xs0);
+            __m128 xf1 = Lerp(GradCoord(vSeed, x0, y1, xd0, yd1), GradCoord(vSeed, x1, y1, xd1, yd1), xs0);
+
+            _mm_storeu_ps(out + i, _mm_mul_ps(Lerp(xf0, xf1, ys0), _mm_set1_ps(1.4247691104677813f)));
+        }
+        return i;
+    }
+
+    FNL_TARGET_SSE41 static int SinglePerlinSSE41(int seed, const float* xs, const float* ys, const float* zs, float* out, int count)
+    {
+        const __m128i vSeed = _mm_set1_epi32(seed);
+        const __m128i vPrimeX = _mm_set1_epi32(PrimeX);
+        const __m128i vPrimeY = _mm_set1_epi32(PrimeY);
+        const __m128i vPrimeZ = _mm_set1_epi32(PrimeZ);
+        const __m128 vOne = _mm_set1_ps(1);
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(xs + i);
+            __m128 y = _mm_loadu_ps(ys + i);
+            __m128 z = _mm_loadu_ps(zs + i);
+
+            __m128i x0 = FastFloor(x);
+            __m128i y0 = FastFloor(y);
+            __m128i z0 = FastFloor(z);
+
+            __m128 xd0 = _mm_sub_ps(x, _mm_cvtepi32_ps(x0));
+            __m128 yd0 = _mm_sub_ps(y, _mm_cvtepi32_ps(y0));
+            __m128 zd0 = _mm_sub_ps(z, _mm_cvtepi32_ps(z0));
+            __m128 xd1 = _mm_sub_ps(xd0, vOne);
+            __m128 yd1 = _mm_sub_ps(yd0, vOne);
+            __m128 zd1 = _mm_sub_ps(zd0, vOne);
+
+            __m128 xs0 = InterpQuintic(xd0);
+            __m128 ys0 = InterpQuintic(yd0);
+            __m128 zs0 = InterpQuintic(zd0);
+
+            x0 = _mm_mullo_epi32(x0, vPrimeX);
+            y0 = _mm_mullo_epi32(y0, vPrimeY);
+            z0 = _mm_mullo_epi32(z0, vPrimeZ);
+            __m128i x1 = _mm_add_epi32(x0, vPrimeX);
+            __m128i y1 = _mm_add_epi32(y0, vPrimeY);
+            __m128i z1 = _mm_add_epi32(z0, vPrimeZ);
+
+            __m128 xf00 = Lerp(GradCoord(vSeed, x0, y0, z0, xd0, yd0, zd0), GradCoord(vSeed, x1, y0, z0, xd1, yd0, zd0), xs0);
+            __m128 xf10 = Lerp(GradCoord(vSeed, x0, y1, z0, xd0, yd1, zd0), GradCoord(vSeed, x1, y1, z0, xd1, yd1, zd0), xs0);
+            __m128 xf01 = Lerp(GradCoord(vSeed, x0, y0, z1, xd0, yd0, zd1), GradCoord(vSeed, x1, y0, z1, xd1, yd0, zd1), xs0);
+            __m128 xf11 = Lerp(GradCoord(vSeed, x0, y1, z1, xd0, yd1, zd1), GradCoord(vSeed, x1, y1, z1, xd1, yd1, zd1), xs0);
+
+            __m128 yf0 = Lerp(xf00, xf10, ys0);
+            __m128 yf1 = Lerp(xf01, xf11, ys0);
+
+            _mm_storeu_ps(out + i, _mm_mul_ps(Lerp(yf0, yf1, zs0), _mm_set1_ps(0.964921414852142333984375f)));
+        }
+        return i;
+    }
+
+    FNL_TARGET_AVX2 static int SinglePerlinAVX2(int seed, const float* xs, const float* ys, float* out, int count)
+    {
+        const __m256i vSeed = _mm256_set1_epi32(seed);
+        const __m256i vPrimeX = _mm256_set1_epi32(PrimeX);
+        const __m256i vPrimeY = _mm256_set1_epi32(PrimeY);
+        const __m256 vOne = _mm256_set1_ps(1);
+
+        int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 x = _mm256_loadu_ps(xs + i);
+            __m256 y = _mm256_loadu_ps(ys + i);
+
+            __m256i x0 = FastFloor(x);
+            __m256i y0 = FastFloor(y);
+
+            __m256 xd0 = _mm256_sub_ps(x, _mm256_cvtepi32_ps(x0));
+            __m256 yd0 = _mm256_sub_ps(y, _mm256_cvtepi32_ps(y0));
+            __m256 xd1 = _mm256_sub_ps(xd0, vOne);
+            __m256 yd1 = _mm256_sub_ps(yd0, vOne);
+
+            __m256 xs0 = InterpQuintic(xd0);
+            __m256 ys0 = InterpQuintic(yd0);
+
+            x0 = _mm256_mullo_epi32(x0, vPrimeX);
+            y0 = _mm256_mullo_epi32(y0, vPrimeY);
+            __m256i x1 = _mm256_add_epi32(x0, vPrimeX);
+            __m256i y1 = _mm256_add_epi32(y0, vPrimeY);
+
+            __m256 xf0 = Lerp(GradCoord(vSeed, x0, y0, xd0, yd0), GradCoord(vSeed, x1, y0, xd1, yd0), xs0);
+            __m256 xf1 = Lerp(GradCoord(vSeed, x0, y1, xd0, yd1), GradCoord(vSeed, x1, y1, xd1, yd1), xs0);
+
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(Lerp(xf0, xf1, ys0), _mm256_set1_ps(1.4247691104677813f)));
+        }
+        return i;
+    }
+
+    FNL_TARGET_AVX2 static int SinglePerlinAVX2(int seed, const float* xs, const float* ys, const float* zs, float* out, int count)
+    {
+        const __m256i vSeed = _mm256_set1_epi32(seed);
+        const __m256i vPrimeX = _mm256_set1_epi32(PrimeX);
+        const __m256i vPrimeY = _mm256_set1_epi32(PrimeY);
+        const __m256i vPrimeZ = _mm256_set1_epi32(PrimeZ);
+        const __m256 vOne = _mm256_set1_ps(1);
+
+        int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 x = _mm256_loadu_ps(xs + i);
+            __m256 y = _mm256_loadu_ps(ys + i);
+            __m256 z = _mm256_loadu_ps(zs + i);
+
+            __m256i x0 = FastFloor(x);
+            __m256i y0 = FastFloor(y);
+            __m256i z0 = FastFloor(z);
+
+            __m256 xd0 = _mm256_sub_ps(x, _mm256_cvtepi32_ps(x0));
+            __m256 yd0 = _mm256_sub_ps(y, _mm256_cvtepi32_ps(y0));
+            __m256 zd0 = _mm256_sub_ps(z, _mm256_cvtepi32_ps(z0));
+            __m256 xd1 = _mm256_sub_ps(xd0, vOne);
+            __m256 yd1 = _mm256_sub_ps(yd0, vOne);
+            __m256 zd1 = _mm256_sub_ps(zd0, vOne);
+
+            __m256 xs0 = InterpQuintic(xd0);
+            __m256 ys0 = InterpQuintic(yd0);
+            __m256 zs0 = InterpQuintic(zd0);
+
+            x0 = _mm256_mullo_epi32(x0, vPrimeX);
+            y0 = _mm256_mullo_epi32(y0, vPrimeY);
+            z0 = _mm256_mullo_epi32(z0, vPrimeZ);
+            __m256i x1 = _mm256_add_epi32(x0, vPrimeX);
+            __m256i y1 = _mm256_add_epi32(y0, vPrimeY);
+            __m256i z1 = _mm256_add_epi32(z0, vPrimeZ);
+
+            __m256 xf00 = Lerp(GradCoord(vSeed, x0, y0, z0, xd0, yd0, zd0), GradCoord(vSeed, x1, y0, z0, xd1, yd0, zd0), xs0);
+            __m256 xf10 = Lerp(GradCoord(vSeed, x0, y1, z0, xd0, yd1, zd0), GradCoord(vSeed, x1, y1, z0, xd1, yd1, zd0), xs0);
+            __m256 xf01 = Lerp(GradCoord(vSeed, x0, y0, z1, xd0, yd0, zd1), GradCoord(vSeed, x1, y0, z1, xd1, yd0, zd1), xs0);
+            __m256 xf11 = Lerp(GradCoord(vSeed, x0, y1, z1, xd0, yd1, zd1), GradCoord(vSeed, x1, y1, z1, xd1, yd1, zd1), xs0);
+
+            __m256 yf0 = Lerp(xf00, xf10, ys0);
+            __m256 yf1 = Lerp(xf01, xf11, ys0);
+
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(Lerp(yf0, yf1, zs0), _mm256_set1_ps(0.964921414852142333984375f)));
+        }
+        return i;
+    }
+
+
+    // SIMD Simplex, branches on the attenuation factors become lane masks
+
+    FNL_TARGET_SSE41 static int SingleSimplexSSE41(int seed, const float* xs, const float* ys, float* out, int count)
+    {
+        const float SQRT3 = 1.7320508075688772935274463415059f;
+        const float G2 = (3 - SQRT3) / 6;
+
+        const __m128i vSeed = _mm_set1_epi32(seed);
+        const __m128i vPrimeX = _mm_set1_epi32(PrimeX);
+        const __m128i vPrimeY = _mm_set1_epi32(PrimeY);
+        const __m128 vG2 = _mm_set1_ps(G2);
+        const __m128 vG2m1 = _mm_set1_ps((float)G2 - 1);
+        const __m128 vHalf = _mm_set1_ps(0.5f);
+        const __m128 vZero = _mm_setzero_ps();
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(xs + i);
+            __m128 y = _mm_loadu_ps(ys + i);
+
+            __m128i xi0 = FastFloor(x);
+            __m128i yj0 = FastFloor(y);
+            __m128 xi = _mm_sub_ps(x, _mm_cvtepi32_ps(xi0));
+            __m128 yi = _mm_sub_ps(y, _mm_cvtepi32_ps(yj0));
+
+            __m128 t = _mm_mul_ps(_mm_add_ps(xi, yi), vG2);
+            __m128 x0 = _mm_sub_ps(xi, t);
+            __m128 y0 = _mm_sub_ps(yi, t);
+
+            __m128i ip = _mm_mullo_epi32(xi0, vPrimeX);
+            __m128i jp = _mm_mullo_epi32(yj0, vPrimeY);
+
+            __m128 a = _mm_sub_ps(_mm_sub_ps(vHalf, _mm_mul_ps(x0, x0)), _mm_mul_ps(y0, y0));
+            __m128 aa = _mm_mul_ps(a, a);
+            __m128 n0 = _mm_mul_ps(_mm_mul_ps(aa, aa), GradCoord(vSeed, ip, jp, x0, y0));
+            n0 = _mm_and_ps(n0, _mm_cmpgt_ps(a, vZero));
+
+            __m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps((float)(2 * (1 - 2 * G2) * (1 / G2 - 2))), t),
+                                  _mm_add_ps(_mm_set1_ps((float)(-2 * (1 - 2 * G2) * (1 - 2 * G2))), a));
+            __m128 x2 = _mm_add_ps(x0, _mm_set1_ps(2 * (float)G2 - 1));
+            __m128 y2 = _mm_add_ps(y0, _mm_set1_ps(2 * (float)G2 - 1));
+            __m128 cc = _mm_mul_ps(c, c);
+            __m128 n2 = _mm_mul_ps(_mm_mul_ps(cc, cc), GradCoord(vSeed, _mm_add_epi32(ip, vPrimeX), _mm_add_epi32(jp, vPrimeY), x2, y2));
+            n2 = _mm_and_ps(n2, _mm_cmpgt_ps(c, vZero));
+
+            __m128 upper = _mm_cmpgt_ps(y0, x0);
+            __m128i upperi = _mm_castps_si128(upper);
+            __m128 x1 = _mm_add_ps(x0, _mm_blendv_ps(vG2m1, vG2, upper));
+            __m128 y1 = _mm_add_ps(y0, _mm_blendv_ps(vG2, vG2m1, upper));
+            __m128i i1 = _mm_add_epi32(ip, _mm_andnot_si128(upperi, vPrimeX));
+            __m128i j1 = _mm_add_epi32(jp, _mm_and_si128(upperi, vPrimeY));
+            __m128 b = _mm_sub_ps(_mm_sub_ps(vHalf, _mm_mul_ps(x1, x1)), _mm_mul_ps(y1, y1));
+            __m128 bb = _mm_mul_ps(b, b);
+            __m128 n1 = _mm_mul_ps(_mm_mul_ps(bb, bb), GradCoord(vSeed, i1, j1, x1, y1));
+            n1 = _mm_and_ps(n1, _mm_cmpgt_ps(b, vZero));
+
+            _mm_storeu_ps(out + i, _mm_mul_ps(_mm_add_ps(_mm_add_ps(n0, n1), n2), _mm_set1_ps(99.83685446303647f)));
+        }
+        return i;
+    }
+
+    FNL_TARGET_AVX2 static int SingleSimplexAVX2(int seed, const float* xs, const float* ys, float* out, int count)
+    {
+        const float SQRT3 = 1.7320508075688772935274463415059f;
+        const float G2 = (3 - SQRT3) / 6;
+
+        const __m256i vSeed = _mm256_set1_epi32(seed);
+        const __m256i vPrimeX = _mm256_set1_epi32(PrimeX);
+        const __m256i vPrimeY = _mm256_set1_epi32(PrimeY);
+        const __m256 vG2 = _mm256_set1_ps(G2);
+        const __m256 vG2m1 = _mm256_set1_ps((float)G2 - 1);
+        const __m256 vHalf = _mm256_set1_ps(0.5f);
+        const __m256 vZero = _mm256_setzero_ps();
+
+        int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 x = _mm256_loadu_ps(xs + i);
+            __m256 y = _mm256_loadu_ps(ys + i);
+
+            __m256i xi0 = FastFloor(x);
+            __m256i yj0 = FastFloor(y);
+            __m256 xi = _mm256_sub_ps(x, _mm256_cvtepi32_ps(xi0));
+            __m256 yi = _mm256_sub_ps(y, _mm256_cvtepi32_ps(yj0));
+
+            __m256 t = _mm256_mul_ps(_mm256_add_ps(xi, yi), vG2);
+            __m256 x0 = _mm256_sub_ps(xi, t);
+            __m256 y0 = _mm256_sub_ps(yi, t);
+
+            __m256i ip = _mm256_mullo_epi32(xi0, vPrimeX);
+            __m256i jp = _mm256_mullo_epi32(yj0, vPrimeY);
+
+            __m256 a = _mm256_sub_ps(_mm256_sub_ps(vHalf, _mm256_mul_ps(x0, x0)), _mm256_mul_ps(y0, y0));
+            __m256 aa = _mm256_mul_ps(a, a);
+            __m256 n0 = _mm256_mul_ps(_mm256_mul_ps(aa, aa), GradCoord(vSeed, ip, jp, x0, y0));
+            n0 = _mm256_and_ps(n0, _mm256_cmp_ps(a, vZero, _CMP_GT_OQ));
+
+            __m256 c = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps((float)(2 * (1 - 2 * G2) * (1 / G2 - 2))), t),
+                                     _mm256_add_ps(_mm256_set1_ps((float)(-2 * (1 - 2 * G2) * (1 - 2 * G2))), a));
+            __m256 x2 = _mm256_add_ps(x0, _mm256_set1_ps(2 * (float)G2 - 1));
+            __m256 y2 = _mm256_add_ps(y0, _mm256_set1_ps(2 * (float)G2 - 1));
+            __m256 cc = _mm256_mul_ps(c, c);
+            __m256 n2 = _mm256_mul_ps(_mm256_mul_ps(cc, cc), GradCoord(vSeed, _mm256_add_epi32(ip, vPrimeX), _mm256_add_epi32(jp, vPrimeY), x2, y2));
+            n2 = _mm256_and_ps(n2, _mm256_cmp_ps(c, vZero, _CMP_GT_OQ));
+
+            __m256 upper = _mm256_cmp_ps(y0, x0, _CMP_GT_OQ);
+            __m256i upperi = _mm256_castps_si256(upper);
+            __m256 x1 = _mm256_add_ps(x0, _mm256_blendv_ps(vG2m1, vG2, upper));
+            __m256 y1 = _mm256_add_ps(y0, _mm256_blendv_ps(vG2, vG2m1, upper));
+            __m256i i1 = _mm256_add_epi32(ip, _mm256_andnot_si256(upperi, vPrimeX));
+            __m256i j1 = _mm256_add_epi32(jp, _mm256_and_si256(upperi, vPrimeY));
+            __m256 b = _mm256_sub_ps(_mm256_sub_ps(vHalf, _mm256_mul_ps(x1, x1)), _mm256_mul_ps(y1, y1));
+            __m256 bb = _mm256_mul_ps(b, b);
+            __m256 n1 = _mm256_mul_ps(_mm256_mul_ps(bb, bb), GradCoord(vSeed, i1, j1, x1, y1));
+            n1 = _mm256_and_ps(n1, _mm256_cmp_ps(b, vZero, _CMP_GT_OQ));
+
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(n0, n1), n2), _mm256_set1_ps(99.83685446303647f)));
+        }
+        return i;
+    }
+
+
+    // SIMD multi-seed Perlin/Simplex, the lattice cell, offsets and falloffs of a run of samples
+    // are computed once and only the hashing and gradients are repeated for each seed
+
+    FNL_TARGET_SSE41 static int SinglePerlinMultiSSE41(const int* seeds, int fields, const float* xs, const float* ys, float* const* out, int count)
+    {
+        const __m128i vPrimeX = _mm_set1_epi32(PrimeX);
+        const __m128i vPrimeY = _mm_set1_epi32(PrimeY);
+        const __m128 vOne = _mm_set1_ps(1);
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(xs + i);
+            __m128 y = _mm_loadu_ps(ys + i);
+
+            __m128i x0 = FastFloor(x);
+            __m128i y0 = FastFloor(y);
+
+            __m128 xd0 = _mm_sub_ps(x, _mm_cvtepi32_ps(x0));
+            __m128 yd0 = _mm_sub_ps(y, _mm_cvtepi32_ps(y0));
+            __m128 xd1 = _mm_sub_ps(xd0, vOne);
+            __m128 yd1 = _mm_sub_ps(yd0, vOne);
+
+            __m128 xs0 = InterpQuintic(xd0);
+            __m128 ys0 = InterpQuintic(yd0);
+
+            x0 = _mm_mullo_epi32(x0, vPrimeX);
+            y0 = _mm_mullo_epi32(y0, vPrimeY);
+            __m128i x1 = _mm_add_epi32(x0, vPrimeX);
+            __m128i y1 = _mm_add_epi32(y0, vPrimeY);
+
+            for (int f = 0; f < fields; f++)
+            {
+                const __m128i vSeed = _mm_set1_epi32(seeds[f]);
+
+                __m128 xf0 = Lerp(GradCoord(vSeed, x0, y0, xd0, yd0), GradCoord(vSeed, x1, y0, xd1, yd0), xs0);
+                __m128 xf1 = Lerp(GradCoord(vSeed, x0, y1, xd0, yd1), GradCoord(vSeed, x1, y1, xd1, yd1), xs0);
+
+                _mm_storeu_ps(out[f] + i, _mm_mul_ps(Lerp(xf0, xf1, ys0), _mm_set1_ps(1.4247691104677813f)));
+            }
+        }
+        return i;
+    }
+
+    FNL_TARGET_SSE41 static int SinglePerlinMultiSSE41(const int* seeds, int fields, const float* xs, const float* ys, const float* zs, float* const* out, int count)
+    {
+        const __m128i vPrimeX = _mm_set1_epi32(PrimeX);
+        const __m128i vPrimeY = _mm_set1_epi32(PrimeY);
+        const __m128i vPrimeZ = _mm_set1_epi32(PrimeZ);
+        const __m128 vOne = _mm_set1_ps(1);
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(xs + i);
+            __m128 y = _mm_loadu_ps(ys + i);
+            __m128 z = _mm_loadu_ps(zs + i);
+
+            __m128i x0 = FastFloor(x);
+            __m128i y0 = FastFloor(y);
+            __m128i z0 = FastFloor(z);
+
+            __m128 xd0 = _mm_sub_ps(x, _mm_cvtepi32_ps(x0));
+            __m128 yd0 = _mm_sub_ps(y, _mm_cvtepi32_ps(y0));
+            __m128 zd0 = _mm_sub_ps(z, _mm_cvtepi32_ps(z0));
+            __m128 xd1 = _mm_sub_ps(xd0, vOne);
+            __m128 yd1 = _mm_sub_ps(yd0, vOne);
+            __m128 zd1 = _mm_sub_ps(zd0, vOne);
+
+            __m128 xs0 = InterpQuintic(xd0);
+            __m128 ys0 = InterpQuintic(yd0);
+            __m128 zs0 = InterpQuintic(zd0);
+
+            x0 = _mm_mullo_epi32(x0, vPrimeX);
+            y0 = _mm_mullo_epi32(y0, vPrimeY);
+            z0 = _mm_mullo_epi32(z0, vPrimeZ);
+            __m128i x1 = _mm_add_epi32(x0, vPrimeX);
+            __m128i y1 = _mm_add_epi32(y0, vPrimeY);
+            __m128i z1 = _mm_add_epi32(z0, vPrimeZ);
+
+            for (int f = 0; f < fields; f++)
+            {
+                const __m128i vSeed = _mm_set1_epi32(seeds[f]);
+
+                __m128 xf00 = Lerp(GradCoord(vSeed, x0, y0, z0, xd0, yd0, zd0), GradCoord(vSeed, x1, y0, z0, xd1, yd0, zd0), xs0);
+                __m128 xf10 = Lerp(GradCoord(vSeed, x0, y1, z0, xd0, yd1, zd0), GradCoord(vSeed, x1, y1, z0, xd1, yd1, zd0), xs0);
+                __m128 xf01 = Lerp(GradCoord(vSeed, x0, y0, z1, xd0, yd0, zd1), GradCoord(vSeed, x1, y0, z1, xd1, yd0, zd1), xs0);
+                __m128 xf11 = Lerp(GradCoord(vSeed, x0, y1, z1, xd0, yd1, zd1), GradCoord(vSeed, x1, y1, z1, xd1, yd1, zd1), xs0);
+
+                __m128 yf0 = Lerp(xf00, xf10, ys0);
+                __m128 yf1 = Lerp(xf01, xf11, ys0);
+
+                _mm_storeu_ps(out[f] + i, _mm_mul_ps(Lerp(yf0, yf1, zs0), _mm_set1_ps(0.964921414852142333984375f)));
+            }
+        }
+        return i;
+    }
+
+    FNL_TARGET_AVX2 static int SinglePerlinMultiAVX2(const int* seeds, int fields, const float* xs, const float* ys, float* const* out, int count)
+    {
+        const __m256i vPrimeX = _mm256_set1_epi32(PrimeX);
+        const __m256i vPrimeY = _mm256_set1_epi32(PrimeY);
+        const __m256 vOne = _mm256_set1_ps(1);
+
+        int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 x = _mm256_loadu_ps(xs + i);
+            __m256 y = _mm256_loadu_ps(ys + i);
+
+            __m256i x0 = FastFloor(x);
+            __m256i y0 = FastFloor(y);
+
+            __m256 xd0 = _mm256_sub_ps(x, _mm256_cvtepi32_ps(x0));
+            __m256 yd0 = _mm256_sub_ps(y, _mm256_cvtepi32_ps(y0));
+            __m256 xd1 = _mm256_sub_ps(xd0, vOne);
+            __m256 yd1 = _mm256_sub_ps(yd0, vOne);
+
+            __m256 xs0 = InterpQuintic(xd0);
+            __m256 ys0 = InterpQuintic(yd0);
+
+            x0 = _mm256_mullo_epi32(x0, vPrimeX);
+            y0 = _mm256_mullo_epi32(y0, vPrimeY);
+            __m256i x1 = _mm256_add_epi32(x0, vPrimeX);
+            __m256i y1 = _mm256_add_epi32(y0, vPrimeY);
+
+            for (int f = 0; f < fields; f++)
+            {
+                const __m256i vSeed = _mm256_set1_epi32(seeds[f]);
+
+                __m256 xf0 = Lerp(GradCoord(vSeed, x0, y0, xd0, yd0), GradCoord(vSeed, x1, y0, xd1, yd0), xs0);
+                __m256 xf1 = Lerp(GradCoord(vSeed, x0, y1, xd0, yd1), GradCoord(vSeed, x1, y1, xd1, yd1), xs0);
+
+                _mm256_storeu_ps(out[f] + i, _mm256_mul_ps(Lerp(xf0, xf1, ys0), _mm256_set1_ps(1.4247691104677813f)));
+            }
+        }
+        return i;
+    }
+
+    FNL_TARGET_AVX2 static int SinglePerlinMultiAVX2(const int* seeds, int fields, const float* xs, const float* ys, const float* zs, float* const* out, int count)
+    {
+        const __m256i vPrimeX = _mm256_set1_epi32(PrimeX);
+        const __m256i vPrimeY = _mm256_set1_epi32(PrimeY);
+        const __m256i vPrimeZ = _mm256_set1_epi32(PrimeZ);
+        const __m256 vOne = _mm256_set1_ps(1);
+
+        int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 x = _mm256_loadu_ps(xs + i);
+            __m256 y = _mm256_loadu_ps(ys + i);
+            __m256 z = _mm256_loadu_ps(zs + i);
+
+            __m256i x0 = FastFloor(x);
+            __m256i y0 = FastFloor(y);
+            __m256i z0 = FastFloor(z);
+
+            __m256 xd0 = _mm256_sub_ps(x, _mm256_cvtepi32_ps(x0));
+            __m256 yd0 = _mm256_sub_ps(y, _mm256_cvtepi32_ps(y0));
+            __m256 zd0 = _mm256_sub_ps(z, _mm256_cvtepi32_ps(z0));
+            __m256 xd1 = _mm256_sub_ps(xd0, vOne);
+            __m256 yd1 = _mm256_sub_ps(yd0, vOne);
+            __m256 zd1 = _mm256_sub_ps(zd0, vOne);
+
+            __m256 xs0 = InterpQuintic(xd0);
+            __m256 ys0 = InterpQuintic(yd0);
+            __m256 zs0 = InterpQuintic(zd0);
+
+            x0 = _mm256_mullo_epi32(x0, vPrimeX);
+            y0 = _mm256_mullo_epi32(y0, vPrimeY);
+            z0 = _mm256_mullo_epi32(z0, vPrimeZ);
+            __m256i x1 = _mm256_add_epi32(x0, vPrimeX);
+            __m256i y1 = _mm256_add_epi32(y0, vPrimeY);
+            __m256i z1 = _mm256_add_epi32(z0, vPrimeZ);
+
+            for (int f = 0; f < fields; f++)
+            {
+                const __m256i vSeed = _mm256_set1_epi32(seeds[f]);
+
+                __m256 xf00 = Lerp(GradCoord(vSeed, x0, y0, z0, xd0, yd0, zd0), GradCoord(vSeed, x1, y0, z0, xd1, yd0, zd0), xs0);
+                __m256 xf10 = Lerp(GradCoord(vSeed, x0, y1, z0, xd0, yd1, zd0), GradCoord(vSeed, x1, y1, z0, xd1, yd1, zd0), xs0);
+                __m256 xf01 = Lerp(GradCoord(vSeed, x0, y0, z1, xd0, yd0, zd1), GradCoord(vSeed, x1, y0, z1, xd1, yd0, zd1), xs0);
+                __m256 xf11 = Lerp(GradCoord(vSeed, x0, y1, z1, xd0, yd1, zd1), GradCoord(vSeed, x1, y1, z1, xd1, yd1, zd1), xs0);
+
+                __m256 yf0 = Lerp(xf00, xf10, ys0);
+                __m256 yf1 = Lerp(xf01, xf11, ys0);
+
+                _mm256_storeu_ps(out[f] + i, _mm256_mul_ps(Lerp(yf0, yf1, zs0), _mm256_set1_ps(0.964921414852142333984375f)));
+            }
+        }
+        return i;
+    }
+
+    FNL_TARGET_SSE41 static int SingleSimplexMultiSSE41(const int* seeds, int fields, const float* xs, const float* ys, float* const* out, int count)
+    {
+        const float SQRT3 = 1.7320508075688772935274463415059f;
+        const float G2 = (3 - SQRT3) / 6;
+
+        const __m128i vPrimeX = _mm_set1_epi32(PrimeX);
+        const __m128i vPrimeY = _mm_set1_epi32(PrimeY);
+        const __m128 vG2 = _mm_set1_ps(G2);
+        const __m128 vG2m1 = _mm_set1_ps((float)G2 - 1);
+        const __m128 vHalf = _mm_set1_ps(0.5f);
+        const __m128 vZero = _mm_setzero_ps();
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(xs + i);
+            __m128 y = _mm_loadu_ps(ys + i);
+
+            __m128i xi0 = FastFloor(x);
+            __m128i yj0 = FastFloor(y);
+            __m128 xi = _mm_sub_ps(x, _mm_cvtepi32_ps(xi0));
+            __m128 yi = _mm_sub_ps(y, _mm_cvtepi32_ps(yj0));
+
+            __m128 t = _mm_mul_ps(_mm_add_ps(xi, yi), vG2);
+            __m128 x0 = _mm_sub_ps(xi, t);
+            __m128 y0 = _mm_sub_ps(yi, t);
+
+            __m128i ip = _mm_mullo_epi32(xi0, vPrimeX);
+            __m128i jp = _mm_mullo_epi32(yj0, vPrimeY);
+
+            __m128 a = _mm_sub_ps(_mm_sub_ps(vHalf, _mm_mul_ps(x0, x0)), _mm_mul_ps(y0, y0));
+            __m128 aa = _mm_mul_ps(a, a);
+            __m128 aaaa = _mm_mul_ps(aa, aa);
+            __m128 aMask = _mm_cmpgt_ps(a, vZero);
+
+            __m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps((float)(2 * (1 - 2 * G2) * (1 / G2 - 2))), t),
+                                  _mm_add_ps(_mm_set1_ps((float)(-2 * (1 - 2 * G2) * (1 - 2 * G2))), a));
+            __m128 x2 = _mm_add_ps(x0, _mm_set1_ps(2 * (float)G2 - 1));
+            __m128 y2 = _mm_add_ps(y0, _mm_set1_ps(2 * (float)G2 - 1));
+            __m128i i2 = _mm_add_epi32(ip, vPrimeX);
+            __m128i j2 = _mm_add_epi32(jp, vPrimeY);
+            __m128 cc = _mm_mul_ps(c, c);
+            __m128 cccc = _mm_mul_ps(cc, cc);
+            __m128 cMask = _mm_cmpgt_ps(c, vZero);
+
+            __m128 upper = _mm_cmpgt_ps(y0, x0);
+            __m128i upperi = _mm_castps_si128(upper);
+            __m128 x1 = _mm_add_ps(x0, _mm_blendv_ps(vG2m1, vG2, upper));
+            __m128 y1 = _mm_add_ps(y0, _mm_blendv_ps(vG2, vG2m1, upper));
+            __m128i i1 = _mm_add_epi32(ip, _mm_andnot_si128(upperi, vPrimeX));
+            __m128i j1 = _mm_add_epi32(jp, _mm_and_si128(upperi, vPrimeY));
+            __m128 b = _mm_sub_ps(_mm_sub_ps(vHalf, _mm_mul_ps(x1, x1)), _mm_mul_ps(y1, y1));
+            __m128 bb = _mm_mul_ps(b, b);
+            __m128 bbbb = _mm_mul_ps(bb, bb);
+            __m128 bMask = _mm_cmpgt_ps(b, vZero);
+
+            for (int f = 0; f < fields; f++)
+            {
+                const __m128i vSeed = _mm_set1_epi32(seeds[f]);
+
+                __m128 n0 = _mm_and_ps(_mm_mul_ps(aaaa, GradCoord(vSeed, ip, jp, x0, y0)), aMask);
+                __m128 n1 = _mm_and_ps(_mm_mul_ps(bbbb, GradCoord(vSeed, i1, j1, x1, y1)), bMask);
+                __m128 n2 = _mm_and_ps(_mm_mul_ps(cccc, GradCoord(vSeed, i2, j2, x2, y2)), cMask);
+
+                _mm_storeu_ps(out[f] + i, _mm_mul_ps(_mm_add_ps(_mm_add_ps(n0, n1), n2), _mm_set1_ps(99.83685446303647f)));
+            }
+        }
+        return i;
+    }
+
+    FNL_TARGET_AVX2 static int SingleSimplexMultiAVX2(const int* seeds, int fields, const float* xs, const float* ys, float* const* out, int count)
+    {
+        const float SQRT3 = 1.7320508075688772935274463415059f;
+        const float G2 = (3 - SQRT3) / 6;
+
+        const __m256i vPrimeX = _mm256_set1_epi32(PrimeX);
+        const __m256i vPrimeY = _mm256_set1_epi32(PrimeY);
+        const __m256 vG2 = _mm256_set1_ps(G2);
+        const __m256 vG2m1 = _mm256_set1_ps((float)G2 - 1);
+        const __m256 vHalf = _mm256_set1_ps(0.5f);
+        const __m256 vZero = _mm256_setzero_ps();
+
+        int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 x = _mm256_loadu_ps(xs + i);
+            __m256 y = _mm256_loadu_ps(ys + i);
+
+            __m256i xi0 = FastFloor(x);
+            __m256i yj0 = FastFloor(y);
+            __m256 xi = _mm256_sub_ps(x, _mm256_cvtepi32_ps(xi0));
+            __m256 yi = _mm256_sub_ps(y, _mm256_cvtepi32_ps(yj0));
+
+            __m256 t = _mm256_mul_ps(_mm256_add_ps(xi, yi), vG2);
+            __m256 x0 = _mm256_sub_ps(xi, t);
+            __m256 y0 = _mm256_sub_ps(yi, t);
+
+            __m256i ip = _mm256_mullo_epi32(xi0, vPrimeX);
+            __m256i jp = _mm256_mullo_epi32(yj0, vPrimeY);
+
+            __m256 a = _mm256_sub_ps(_mm256_sub_ps(vHalf, _mm256_mul_ps(x0, x0)), _mm256_mul_ps(y0, y0));
+            __m256 aa = _mm256_mul_ps(a, a);
+            __m256 aaaa = _mm256_mul_ps(aa, aa);
+            __m256 aMask = _mm256_cmp_ps(a, vZero, _CMP_GT_OQ);
+
+            __m256 c = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps((float)(2 * (1 - 2 * G2) * (1 / G2 - 2))), t),
+                                     _mm256_add_ps(_mm256_set1_ps((float)(-2 * (1 - 2 * G2) * (1 - 2 * G2))), a));
+            __m256 x2 = _mm256_add_ps(x0, _mm256_set1_ps(2 * (float)G2 - 1));
+            __m256 y2 = _mm256_add_ps(y0, _mm256_set1_ps(2 * (float)G2 - 1));
+            __m256i i2 = _mm256_add_epi32(ip, vPrimeX);
+            __m256i j2 = _mm256_add_epi32(jp, vPrimeY);
+            __m256 cc = _mm256_mul_ps(c, c);
+            __m256 cccc = _mm256_mul_ps(cc, cc);
+            __m256 cMask = _mm256_cmp_ps(c, vZero, _CMP_GT_OQ);
+
+            __m256 upper = _mm256_cmp_ps(y0, x0, _CMP_GT_OQ);
+            __m256i upperi = _mm256_castps_si256(upper);
+            __m256 x1 = _mm256_add_ps(x0, _mm256_blendv_ps(vG2m1, vG2, upper));
+            __m256 y1 = _mm256_add_ps(y0, _mm256_blendv_ps(vG2, vG2m1, upper));
+            __m256i i1 = _mm256_add_epi32(ip, _mm256_andnot_si256(upperi, vPrimeX));
+            __m256i j1 = _mm256_add_epi32(jp, _mm256_and_si256(upperi, vPrimeY));
+            __m256 b = _mm256_sub_ps(_mm256_sub_ps(vHalf, _mm256_mul_ps(x1, x1)), _mm256_mul_ps(y1, y1));
+            __m256 bb = _mm256_mul_ps(b, b);
+            __m256 bbbb = _mm256_mul_ps(bb, bb);
+            __m256 bMask = _mm256_cmp_ps(b, vZero, _CMP_GT_OQ);
+
+            for (int f = 0; f < fields; f++)
+            {
+                const __m256i vSeed = _mm256_set1_epi32(seeds[f]);
+
+                __m256 n0 = _mm256_and_ps(_mm256_mul_ps(aaaa, GradCoord(vSeed, ip, jp, x0, y0)), aMask);
+                __m256 n1 = _mm256_and_ps(_mm256_mul_ps(bbbb, GradCoord(vSeed, i1, j1, x1, y1)), bMask);
+                __m256 n2 = _mm256_and_ps(_mm256_mul_ps(cccc, GradCoord(vSeed, i2, j2, x2, y2)), cMask);
+
+                _mm256_storeu_ps(out[f] + i, _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(n0, n1), n2), _mm256_set1_ps(99.83685446303647f)));
+            }
+        }
+        return i;
+    }
+
+#endif
+
+
+    // Domain Warp
+
+    template <typename FNfloat>
+    void DoSingleDomainWarp(int seed, float amp, float freq, FNfloat x, FNfloat y, FNfloat& xr, FNfloat& yr) const
+    {
+        switch (mDomainWarpType)
+        {
+        case DomainWarpType_OpenSimplex2:
+            SingleDomainWarpSimplexGradient(seed, amp * 38.283687591552734375f, freq, x, y, xr, yr, false);
+            break;
+        case DomainWarpType_OpenSimplex2Reduced:
+            SingleDomainWarpSimplexGradient(seed, amp * 16.0f, freq, x, y, xr, yr, true);
+            break;
+        case DomainWarpType_BasicGrid:
+            SingleDomainWarpBasicGrid(seed, amp, freq, x, y, xr, yr);
+            break;
+        }
+    }
+
+    template <typename FNfloat>
+    void DoSingleDomainWarp(int seed, float amp, float freq, FNfloat x, FNfloat y, FNfloat z, FNfloat& xr, FNfloat& yr, FNfloat& zr) const
+    {
+        switch (mDomainWarpType)
+        {
+        case DomainWarpType_OpenSimplex2:
+            SingleDomainWarpOpenSimplex2Gradient(seed, amp * 32.69428253173828125f, freq, x, y, z, xr, yr, zr, false);
+            break;
+        case DomainWarpType_OpenSimplex2Reduced:
+            SingleDomainWarpOpenSimplex2Gradient(seed, amp * 7.71604938271605f, freq, x, y, z, xr, yr, zr, true);
+            break;
+        case DomainWarpType_BasicGrid:
+            SingleDomainWarpBasicGrid(seed, amp, freq, x, y, z, xr, yr, zr);
+            break;
+        }
+    }
+
+
+    // Domain Warp Single Wrapper
+
+    template <typename FNfloat>
+    void DomainWarpSingle(FNfloat& x, FNfloat& y) const
+    {
+        int seed = mSeed;
+        float amp = mDomainWarpAmp * mFractalBounding;
+        float freq = mFrequency;
+
+        FNfloat xs = x;
+        FNfloat ys = y;
+        TransformDomainWarpCoordinate(xs, ys);
+
+        DoSingleDomainWarp(seed, amp, freq, xs, ys, x, y);
+    }
+
+    template <typename FNfloat>
+    void DomainWarpSingle(FNfloat& x, FNfloat& y, FNfloat& z) const
+    {
+        int seed = mSeed;
+        float amp = mDomainWarpAmp * mFractalBounding;
+        float freq = mFrequency;
+
+        FNfloat xs = x;
+        FNfloat ys = y;
+        FNfloat zs = z;
+        TransformDomainWarpCoordinate(xs, ys, zs);
+
+        DoSingleDomainWarp(seed, amp, freq, xs, ys, zs, x, y, z);
+    }
+
+
+    // Domain Warp Fractal Progressive
+
+    template <typename FNfloat>
+    void DomainWarpFractalProgressive(FNfloat& x, FNfloat& y) const
+    {
+        int seed = mSeed;
+        float amp = mDomainWarpAmp * mFractalBounding;
+        float freq = mFrequency;
+
+        for (int i = 0; i < mOctaves; i++)
+        {
+            FNfloat xs = x;
+            FNfloat ys = y;
+            TransformDomainWarpCoordinate(xs, ys);
+
+            DoSingleDomainWarp(seed, amp, freq, xs, ys, x, y);
+
+            seed++;
+            amp *= mGain;
+            freq *= mLacunarity;
+        }
+    }
+
+    template <typename FNfloat>
+    void DomainWarpFractalProgressive(FNfloat& x, FNfloat& y, FNfloat& z) const
+    {
+        int seed = mSeed;
+        float amp = mDomainWarpAmp * mFractalBounding;
+        float freq = mFrequency;
+
+        for (int i = 0; i < mOctaves; i++)
+        {
+            FNfloat xs = x;
+            FNfloat ys = y;
+            FNfloat zs = z;
+            TransformDomainWarpCoordinate(xs, ys, zs);
+
+            DoSingleDomainWarp(seed, amp, freq, xs, ys, zs, x, y, z);
+
+            seed++;
+            amp *= mGain;
+            freq *= mLacunarity;
+        }
+    }
+
+
+    // Domain Warp Fractal Independant
+
+    template <typename FNfloat>
+    void DomainWarpFractalIndependent(FNfloat& x, FNfloat& y) const
+    {
+        FNfloat xs = x;
+        FNfloat ys = y;
+        TransformDomainWarpCoordinate(xs, ys);
+
+        int seed = mSeed;
+        float amp = mDomainWarpAmp * mFractalBounding;
+        float freq = mFrequency;
+
+        for (int i = 0; i < mOctaves; i++)
+        {
+            DoSingleDomainWarp(seed, amp, freq, xs, ys, x, y);
+
+            seed++;
+            amp *= mGain;
+            freq *= mLacunarity;
+        }
+    }
+
+    template <typename FNfloat>
+    void DomainWarpFractalIndependent(FNfloat& x, FNfloat& y, FNfloat& z) const
+    {
+        FNfloat xs = x;
+        FNfloat ys = y;
+        FNfloat zs = z;
+        TransformDomainWarpCoordinate(xs, ys, zs);
+
+        int seed = mSeed;
+        float amp = mDomainWarpAmp * mFractalBounding;
+        float freq = mFrequency;
+
+        for (int i = 0; i < mOctaves; i++)
+        {
+            DoSingleDomainWarp(seed, amp, freq, xs, ys, zs, x, y, z);
+
+            seed++;
+            amp *= mGain;
+            freq *= mLacunarity;
+        }
+    }
+
+
+    // Domain Warp Basic Grid
+
+    template <typename FNfloat>
+    void SingleDomainWarpBasicGrid(int seed, float warpAmp, float frequency, FNfloat x, FNfloat y, FNfloat& xr, FNfloat& yr) const
+    {
+        FNfloat xf = x * frequency;
+        FNfloat yf = y * frequency;
+
+        int x0 = FastFloor(xf);
+        int y0 = FastFloor(yf);
+
+        float xs = InterpHermite((float)(xf - x0));
+        float ys = InterpHermite((float)(yf - y0));
+
+        x0 *= PrimeX;
+        y0 *= PrimeY;
+        int x1 = x0 + PrimeX;
+        int y1 = y0 + PrimeY;
+
+        int hash0 = Hash(seed, x0, y0) & (255 << 1);
+        int hash1 = Hash(seed, x1, y0) & (255 << 1);
+
+        float lx0x = Lerp(Lookup<float>::RandVecs2D[hash0], Lookup<float>::RandVecs2D[hash1], xs);
+        float ly0x = Lerp(Lookup<float>::RandVecs2D[hash0 | 1], Lookup<float>::RandVecs2D[hash1 | 1], xs);
+
+        hash0 = Hash(seed, x0, y1) & (255 << 1);
+        hash1 = Hash(seed, x1, y1) & (255 << 1);
+
+        float lx1x = Lerp(Lookup<float>::RandVecs2D[hash0], Lookup<float>::RandVecs2D[hash1], xs);
+        float ly1x = Lerp(Lookup<float>::RandVecs2D[hash0 | 1], Lookup<float>::RandVecs2D[hash1 | 1], xs);
+
+        xr += Lerp(lx0x, lx1x, ys) * warpAmp;
+        yr += Lerp(ly0x, ly1x, ys) * warpAmp;
+    }
+
+    template <typename FNfloat>
+    void SingleDomainWarpBasicGrid(int seed, float warpAmp, float frequency, FNfloat x, FNfloat y, FNfloat z, FNfloat& xr, FNfloat& yr, FNfloat& zr) const
+    {
+        FNfloat xf = x * frequency;
+        FNfloat yf = y * frequency;
+        FNfloat zf = z * frequency;
+
+        int x0 = FastFloor(xf);
+        int y0 = FastFloor(yf);
+        int z0 = FastFloor(zf);
+
+        float xs = InterpHermite((float)(xf - x0));
+        float ys = InterpHermite((float)(yf - y0));
+        float zs = InterpHermite((float)(zf - z0));
+
+        x0 *= PrimeX;
+        y0 *= PrimeY;
+        z0 *= PrimeZ;
+        int x1 = x0 + PrimeX;
+        int y1 = y0 + PrimeY;
+        int z1 = z0 + PrimeZ;
+
+        int hash0 = Hash(seed, x0, y0, z0) & (255 << 2);
+        int hash1 = Hash(seed, x1, y0, z0) & (255 << 2);
+
+        float lx0x = Lerp(Lookup<float>::RandVecs3D[hash0], Lookup<float>::RandVecs3D[hash1], xs);
+        float ly0x = Lerp(Lookup<float>::RandVecs3D[hash0 | 1], Lookup<float>::RandVecs3D[hash1 | 1], xs);
+        float lz0x = Lerp(Lookup<float>::RandVecs3D[hash0 | 2], Lookup<float>::RandVecs3D[hash1 | 2], xs);
+
+        hash0 = Hash(seed, x0, y1, z0) & (255 << 2);
+        hash1 = Hash(seed, x1, y1, z0) & (255 << 2);
+
+        float lx1x = Lerp(Lookup<float>::RandVecs3D[hash0], Lookup<float>::RandVecs3D[hash1], xs);
+        float ly1x = Lerp(Lookup<float>::RandVecs3D[hash0 | 1], Lookup<float>::RandVecs3D[hash1 | 1], xs);
+        float lz1x = Lerp(Lookup<float>::RandVecs3D[hash0 | 2], Lookup<float>::RandVecs3D[hash1 | 2], xs);
+
+        float lx0y = Lerp(lx0x, lx1x, ys);
+        float ly0y = Lerp(ly0x, ly1x, ys);
+        float lz0y = Lerp(lz0x, lz1x, ys);
+
+        hash0 = Hash(seed, x0, y0, z1) & (255 << 2);
+        hash1 = Hash(seed, x1, y0, z1) & (255 << 2);
+
+        lx0x = Lerp(Lookup<float>::RandVecs3D[hash0], Lookup<float>::RandVecs3D[hash1], xs);
+        ly0x = Lerp(Lookup<float>::RandVecs3D[hash0 | 1], Lookup<float>::RandVecs3D[hash1 | 1], xs);
+        lz0x = Lerp(Lookup<float>::RandVecs3D[hash0 | 2], Lookup<float>::RandVecs3D[hash1 | 2], xs);
+
+        hash0 = Hash(seed, x0, y1, z1) & (255 << 2);
+        hash1 = Hash(seed, x1, y1, z1) & (255 << 2);
+
+        lx1x = Lerp(Lookup<float>::RandVecs3D[hash0], Lookup<float>::RandVecs3D[hash1], xs);
+        ly1x = Lerp(Lookup<float>::RandVecs3D[hash0 | 1], Lookup<float>::RandVecs3D[hash1 | 1], xs);
+        lz1x = Lerp(Lookup<float>::RandVecs3D[hash0 | 2], Lookup<float>::RandVecs3D[hash1 | 2], xs);
+
+        xr += Lerp(lx0y, Lerp(lx0x, lx1x, ys), zs) * warpAmp;
+        yr += Lerp(ly0y, Lerp(ly0x, ly1x, ys), zs) * warpAmp;
+        zr += Lerp(lz0y, Lerp(lz0x, lz1x, ys), zs) * warpAmp;
+    }
+
+
+    // Domain Warp Simplex/OpenSimplex2
+
+    template <typename FNfloat>
+    void SingleDomainWarpSimplexGradient(int seed, float warpAmp, float frequency, FNfloat x, FNfloat y, FNfloat& xr, FNfloat& yr, bool outGradOnly) const
+    {
+        const float SQRT3 = 1.7320508075688772935274463415059f;
+        const float G2 = (3 - SQRT3) / 6;
+
+        x *= frequency;
+        y *= frequency;
+
+        /*
+         * --- Skew moved to TransformNoiseCoordinate method ---
+         * const FNfloat F2 = 0.5f * (SQRT3 - 1);
+         * FNfloat s = (x + y) * F2;
+         * x += s; y += s;
+        */
+
+        int i = FastFloor(x);
+        int j = FastFloor(y);
+        float xi = (float)(x - i);
+        float yi = (float)(y - j);
+
+        float t = (xi + yi) * G2;
+        float x0 = (float)(xi - t);
+        float y0 = (float)(yi - t);
+
+        i *= PrimeX;
+        j *= PrimeY;
+
+        float vx, vy;
+        vx = vy = 0;
+
+        float a = 0.5f - x0 * x0 - y0 * y0;
+        if (a > 0)
+        {
+            float aaaa = (a * a) * (a * a);
+            float xo, yo;
+            if (outGradOnly)
+                GradCoordOut(seed, i, j, xo, yo);
+            else
+                GradCoordDual(seed, i, j, x0, y0, xo, yo);
+            vx += aaaa * xo;
+            vy += aaaa * yo;
+        }
+
+        float c = (float)(2 * (1 - 2 * G2) * (1 / G2 - 2)) * t + ((float)(-2 * (1 - 2 * G2) * (1 - 2 * G2)) + a);
+        if (c > 0)
+        {
+            float x2 = x0 + (2 * (float)G2 - 1);
+            float y2 = y0 + (2 * (float)G2 - 1);
+            float cccc = (c * c) * (c * c);
+            float xo, yo;
+            if (outGradOnly)
+                GradCoordOut(seed, i + PrimeX, j + PrimeY, xo, yo);
+            else
+                GradCoordDual(seed, i + PrimeX, j + PrimeY, x2, y2, xo, yo);
+            vx += cccc * xo;
+            vy += cccc * yo;
+        }
+
+        if (y0 > x0)
+        {
+            float x1 = x0 + (float)G2;
+            float y1 = y0 + ((float)G2 - 1);
+            float b = 0.5f - x1 * x1 - y1 * y1;
+            if (b > 0)
+            {
+                float bbbb = (b * b) * (b * b);
+                float xo, yo;
+                if (outGradOnly)
+                    GradCoordOut(seed, i, j + PrimeY, xo, yo);
+                else
+                    GradCoordDual(seed, i, j + PrimeY, x1, y1, xo, yo);
+                vx += bbbb * xo;
+                vy += bbbb * yo;
+            }
+        }
+        else
+        {
+            float x1 = x0 + ((float)G2 - 1);
+            float y1 = y0 + (float)G2;
+            float b = 0.5f - x1 * x1 - y1 * y1;
+            if (b > 0)
+            {
+                float bbbb = (b * b) * (b * b);
+                float xo, yo;
+                if (outGradOnly)
+                    GradCoordOut(seed, i + PrimeX, j, xo, yo);
+                else
+                    GradCoordDual(seed, i + PrimeX, j, x1, y1, xo, yo);
+                vx += bbbb * xo;
+                vy += bbbb * yo;
+            }
+        }
+
+        xr += vx * warpAmp;
+        yr += vy * warpAmp;
+    }
+
+    template <typename FNfloat>
+    void SingleDomainWarpOpenSimplex2Gradient(int seed, float warpAmp, float frequency, FNfloat x, FNfloat y, FNfloat z, FNfloat& xr, FNfloat& yr, FNfloat& zr, bool outGradOnly) const
+    {
+        x *= frequency;
+        y *= frequency;
+        z *= frequency;
+
+        /*
+         * --- Rotation moved to TransformDomainWarpCoordinate method ---
+         * const FNfloat R3 = (FNfloat)(2.0 / 3.0);
+         * FNfloat r = (x + y + z) * R3; // Rotation, not skew
+         * x = r - x; y = r - y; z = r - z;
+        */
+
+        int i = FastRound(x);
+        int j = FastRound(y);
+        int k = FastRound(z);
+        float x0 = (float)x - i;
+        float y0 = (float)y - j;
+        float z0 = (float)z - k;
+
+        int xNSign = (int)(-x0 - 1.0f) | 1;
+        int yNSign = (int)(-y0 - 1.0f) | 1;
+        int zNSign = (int)(-z0 - 1.0f) | 1;
+
+        float ax0 = xNSign * -x0;
+        float ay0 = yNSign * -y0;
+        float az0 = zNSign * -z0;
+
+        i *= PrimeX;
+        j *= PrimeY;
+        k *= PrimeZ;
+
+        float vx, vy, vz;
+        vx = vy = vz = 0;
+
+        float a = (0.6f - x0 * x0) - (y0 * y0 + z0 * z0);
+        for (int l = 0; l < 2; l++)
+        {
+            if (a > 0)
+            {
+                float aaaa = (a * a) * (a * a);
+                float xo, yo, zo;
+                if (outGradOnly)
+                    GradCoordOut(seed, i, j, k, xo, yo, zo);
+                else
+                    GradCoordDual(seed, i, j, k, x0, y0, z0, xo, yo, zo);
+                vx += aaaa * xo;
+                vy += aaaa * yo;
+                vz += aaaa * zo;
+            }
+
+            float b = a + 1;
+            int i1 = i;
+            int j1 = j;
+            int k1 = k;
+            float x1 = x0;
+            float y1 = y0;
+            float z1 = z0;
+
+            if (ax0 >= ay0 && ax0 >= az0)
+            {
+                x1 += xNSign;
+                b -= xNSign * 2 * x1;
+                i1 -= xNSign * PrimeX;
+            }
+            else if (ay0 > ax0 && ay0 >= az0)
+            {
+                y1 += yNSign;
+                b -= yNSign * 2 * y1;
+                j1 -= yNSign * PrimeY;
+            }
+            else
+            {
+                z1 += zNSign;
+                b -= zNSign * 2 * z1;
+                k1 -= zNSign * PrimeZ;
+            }
+
+            if (b > 0)
+            {
+                float bbbb = (b * b) * (b * b);
+                float xo, yo, zo;
+                if (outGradOnly)
+                    GradCoordOut(seed, i1, j1, k1, xo, yo, zo);
+                else
+                    GradCoordDual(seed, i1, j1, k1, x1, y1, z1, xo, yo, zo);
+                vx += bbbb * xo;
+                vy += bbbb * yo;
+                vz += bbbb * zo;
+            }
+
+            if (l == 1) break;
+
+            ax0 = 0.5f - ax0;
+            ay0 = 0.5f - ay0;
+            az0 = 0.5f - az0;
+
+            x0 = xNSign * ax0;
+            y0 = yNSign * ay0;
+            z0 = zNSign * az0;
+
+            a += (0.75f - ax0) - (ay0 + az0);
+
+            i += (xNSign >> 1) & PrimeX;
+            j += (yNSign >> 1) & PrimeY;
+            k += (zNSign >> 1) & PrimeZ;
+
+            xNSign = -xNSign;
+            yNSign = -yNSign;
+            zNSign = -zNSign;
+
+            seed += 1293373;
+        }
+
+        xr += vx * warpAmp;
+        yr += vy * warpAmp;
+        zr += vz * warpAmp;
+    }
+
+    // Domain Warp Blocks, same math as the single position versions applied to a run of positions
+
+    void TransformDomainWarpCoordinateBlock(float* xs, float* ys, int count) const
+    {
+        switch (mDomainWarpType)
+        {
+        case DomainWarpType_OpenSimplex2:
+        case DomainWarpType_OpenSimplex2Reduced:
+            {
+                const float SQRT3 = (float)1.7320508075688772935274463415059;
+                const float F2 = 0.5f * (SQRT3 - 1);
+                for (int i = 0; i < count; i++)
+                {
+                    float t = (xs[i] + ys[i]) * F2;
+                    xs[i] += t;
+                    ys[i] += t;
+                }
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    void TransformDomainWarpCoordinateBlock(float* xs, float* ys, float* zs, int count) const
+    {
+        switch (mWarpTransformType3D)
+        {
+        case TransformType3D_ImproveXYPlanes:
+            for (int i = 0; i < count; i++)
+            {
+                float xy = xs[i] + ys[i];
+                float s2 = xy * -(float)0.211324865405187;
+                zs[i] *= (float)0.577350269189626;
+                xs[i] += s2 - zs[i];
+                ys[i] = ys[i] + s2 - zs[i];
+                zs[i] += xy * (float)0.577350269189626;
+            }
+            break;
+        case TransformType3D_ImproveXZPlanes:
+            for (int i = 0; i < count; i++)
+            {
+                float xz = xs[i] + zs[i];
+                float s2 = xz * -(float)0.211324865405187;
+                ys[i] *= (float)0.577350269189626;
+                xs[i] += s2 - ys[i];
+                zs[i] += s2 - ys[i];
+                ys[i] += xz * (float)0.577350269189626;
+            }
+            break;
+        case TransformType3D_DefaultOpenSimplex2:
+            {
+                const float R3 = (float)(2.0 / 3.0);
+                for (int i = 0; i < count; i++)
+                {
+                    float r = (xs[i] + ys[i] + zs[i]) * R3; // Rotation, not skew
+                    xs[i] = r - xs[i];
+                    ys[i] = r - ys[i];
+                    zs[i] = r - zs[i];
+                }
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    void DomainWarpBlock(float* xs, float* ys, int count) const
+    {
+        switch (mFractalType)
+        {
+        default:
+            DomainWarpSingleBlock(xs, ys, count);
+            break;
+        case FractalType_DomainWarpProgressive:
+            DomainWarpFractalProgressiveBlock(xs, ys, count);
+            break;
+        case FractalType_DomainWarpIndependent:
+            DomainWarpFractalIndependentBlock(xs, ys, count);
+            break;
+        }
+    }
+
+    void DomainWarpBlock(float* xs, float* ys, float* zs, int count) const
+    {
+        switch (mFractalType)
+        {
+        default:
+            DomainWarpSingleBlock(xs, ys, zs, count);
+            break;
+        case FractalType_DomainWarpProgressive:
+            DomainWarpFractalProgressiveBlock(xs, ys, zs, count);
+            break;
+        case FractalType_DomainWarpIndependent:
+            DomainWarpFractalIndependentBlock(xs, ys, zs, count);
+            break;
+        }
+    }
+
+    void DoSingleDomainWarpBlock(int seed, float amp, float freq, const float* xw, const float* yw, float* xs, float* ys, int count) const
+    {
+        switch (mDomainWarpType)
+        {
+        case DomainWarpType_OpenSimplex2:
+            SingleDomainWarpSimplexGradientBlock(seed, amp * 38.283687591552734375f, freq, xw, yw, xs, ys, count, false);
+            break;
+        case DomainWarpType_OpenSimplex2Reduced:
+            SingleDomainWarpSimplexGradientBlock(seed, amp * 16.0f, freq, xw, yw, xs, ys, count, true);
+            break;
+        case DomainWarpType_BasicGrid:
+            SingleDomainWarpBasicGridBlock(seed, amp, freq, xw, yw, xs, ys, count);
+            break;
+        }
+    }
+
+    void DoSingleDomainWarpBlock(int seed, float amp, float freq, const float* xw, const float* yw, const float* zw, float* xs, float* ys, float* zs, int count) const
+    {
+        switch (mDomainWarpType)
+        {
+        case DomainWarpType_OpenSimplex2:
+            for (int i = 0; i < count; i++)
+                SingleDomainWarpOpenSimplex2Gradient(seed, amp * 32.69428253173828125f, freq, xw[i], yw[i], zw[i], xs[i], ys[i], zs[i], false);
+            break;
+        case DomainWarpType_OpenSimplex2Reduced:
+            for (int i = 0; i < count; i++)
+                SingleDomainWarpOpenSimplex2Gradient(seed, amp * 7.71604938271605f, freq, xw[i], yw[i], zw[i], xs[i], ys[i], zs[i], true);
+            break;
+        case DomainWarpType_BasicGrid:
+            for (int i = 0; i < count; i++)
+                SingleDomainWarpBasicGrid(seed, amp, freq, xw[i], yw[i], zw[i], xs[i], ys[i], zs[i]);
+            break;
+        }
+    }
+
+    // xw/yw/zw hold the warp-space copy of the positions the warp is sampled at
+
+    void DomainWarpSingleBlock(float* xs, float* ys, int count) const
+    {
+        int seed = mSeed;
+        float amp = mDomainWarpAmp * mFractalBounding;
+        float freq = mFrequency;
+
+        float xw[BlockSize];
+        float yw[BlockSize];
+        for (int i = 0; i < count; i++)
+        {
+            xw[i] = xs[i];
+            yw[i] = ys[i];
+        }
+        TransformDomainWarpCoordinateBlock(xw, yw, count);
+
+        DoSingleDomainWarpBlock(seed, amp, freq, xw, yw, xs, ys, count);
+    }
+
+    void DomainWarpSingleBlock(float* xs, float* ys, float* zs, int count) const
+    {
+        int seed = mSeed;
+        float amp = mDomainWarpAmp * mFractalBounding;
+        float freq = mFrequency;
+
+        float xw[BlockSize];
+        float yw[BlockSize];
+        float zw[BlockSize];
+        for (int i = 0; i < count; i++)
+        {
+            xw[i] = xs[i];
+            yw[i] = ys[i];
+            zw[i] = zs[i];
+        }
+        TransformDomainWarpCoordinateBlock(xw, yw, zw, count);
+
+        DoSingleDomainWarpBlock(seed, amp, freq, xw, yw, zw, xs, ys, zs, count);
+    }
+
+    void DomainWarpFractalProgressiveBlock(float* xs, float* ys, int count) const
+    {
+        int seed = mSeed;
+        float amp = mDomainWarpAmp * mFractalBounding;
+        float freq = mFrequency;
+
+        float xw[BlockSize];
+        float yw[BlockSize];
+
+        for (int o = 0; o < mOctaves; o++)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                xw[i] = xs[i];
+                yw[i] = ys[i];
+            }
+            TransformDomainWarpCoordinateBlock(xw, yw, count);
+
+            DoSingleDomainWarpBlock(seed, amp, freq, xw, yw, xs, ys, count);
+
+            seed++;
+            amp *= mGain;
+            freq *= mLacunarity;
+        }
+    }
+
+    void DomainWarpFractalProgressiveBlock(float* xs, float* ys, float* zs, int count) const
+    {
+        int seed = mSeed;
+        float amp = mDomainWarpAmp * mFractalBounding;
+        float freq = mFrequency;
+
+        float xw[BlockSize];
+        float yw[BlockSize];
+        float zw[BlockSize];
+
+        for (int o = 0; o < mOctaves; o++)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                xw[i] = xs[i];
+                yw[i] = ys[i];
+                zw[i] = zs[i];
+            }
+            TransformDomainWarpCoordinateBlock(xw, yw, zw, count);
+
+            DoSingleDomainWarpBlock(seed, amp, freq, xw, yw, zw, xs, ys, zs, count);
+
+            seed++;
+            amp *= mGain;
+            freq *= mLacunarity;
+        }
+    }
+
+    void DomainWarpFractalIndependentBlock(float* xs, float* ys, int count) const
+    {
+        float xw[BlockSize];
+        float yw[BlockSize];
+        for (int i = 0; i < count; i++)
+        {
+            xw[i] = xs[i];
+            yw[i] = ys[i];
+        }
+        TransformDomainWarpCoordinateBlock(xw, yw, count);
+
+        int seed = mSeed;
+        float amp = mDomainWarpAmp * mFractalBounding;
+        float freq = mFrequency;
+
+        for (int o = 0; o < mOctaves; o++)
+        {
+            DoSingleDomainWarpBlock(seed, amp, freq, xw, yw, xs, ys, count);
+
+            seed++;
+            amp *= mGain;
+            freq *= mLacunarity;
+        }
+    }
+
+    void DomainWarpFractalIndependentBlock(float* xs, float* ys, float* zs, int count) const
+    {
+        float xw[BlockSize];
+        float yw[BlockSize];
+        float zw[BlockSize];
+        for (int i = 0; i < count; i++)
+        {
+            xw[i] = xs[i];
+            yw[i] = ys[i];
+            zw[i] = zs[i];
+        }
+        TransformDomainWarpCoordinateBlock(xw, yw, zw, count);
+
+        int seed = mSeed;
+        float amp = mDomainWarpAmp * mFractalBounding;
+        float freq = mFrequency;
+
+        for (int o = 0; o < mOctaves; o++)
+        {
+            DoSingleDomainWarpBlock(seed, amp, freq, xw, yw, zw, xs, ys, zs, count);
+
+            seed++;
+            amp *= mGain;
+            freq *= mLacunarity;
+        }
+    }
+
+
+    // Batch Domain Warp, 2D vectorized when available with a scalar tail
+
+    void SingleDomainWarpBasicGridBlock(int seed, float warpAmp, float frequency, const float* xs, const float* ys, float* xr, float* yr, int count) const
+    {
+        int i = 0;
+#ifdef FNL_SIMD_X86
+        switch (mSimdLevel)
+        {
+        case SimdLevel_AVX2:
+            i = SingleDomainWarpBasicGridAVX2(seed, warpAmp, frequency, xs, ys, xr, yr, count);
+            break;
+        case SimdLevel_SSE41:
+            i = SingleDomainWarpBasicGridSSE41(seed, warpAmp, frequency, xs, ys, xr, yr, count);
+            break;
+        default:
+            break;
+        }
+#endif
+        for (; i < count; i++) SingleDomainWarpBasicGrid(seed, warpAmp, frequency, xs[i], ys[i], xr[i], yr[i]);
+    }
+
+    void SingleDomainWarpSimplexGradientBlock(int seed, float warpAmp, float frequency, const float* xs, const float* ys, float* xr, float* yr, int count, bool outGradOnly) const
+    {
+        int i = 0;
+#ifdef FNL_SIMD_X86
+        switch (mSimdLevel)
+        {
+        case SimdLevel_AVX2:
+            i = SingleDomainWarpSimplexGradientAVX2(seed, warpAmp, frequency, xs, ys, xr, yr, count, outGradOnly);
+            break;
+        case SimdLevel_SSE41:
+            i = SingleDomainWarpSimplexGradientSSE41(seed, warpAmp, frequency, xs, ys, xr, yr, count, outGradOnly);
+            break;
+        default:
+            break;
+        }
+#endif
+        for (; i < count; i++) SingleDomainWarpSimplexGradient(seed, warpAmp, frequency, xs[i], ys[i], xr[i], yr[i], outGradOnly);
+    }
+
+#ifdef FNL_SIMD_X86
+
+    // The scalar warps only add the corners whose falloff is positive; here every corner is
+    // evaluated and a lane keeps its previous sum where the scalar code would have skipped,
+    // so sums (down to the sign of a zero) match the scalar path
+
+    FNL_TARGET_SSE41 static __m128 InterpHermite(__m128 t)
+    {
+        return _mm_mul_ps(_mm_mul_ps(t, t), _mm_sub_ps(_mm_set1_ps(3), _mm_mul_ps(_mm_set1_ps(2), t)));
+    }
+
+    FNL_TARGET_SSE41 static void GradCoordOut(__m128i seed, __m128i xPrimed, __m128i yPrimed, __m128& xo, __m128& yo)
+    {
+        __m128i hash = _mm_and_si128(Hash(seed, xPrimed, yPrimed), _mm_set1_epi32(255 << 1));
+
+        xo = Gather(Lookup<float>::RandVecs2D, hash, 0);
+        yo = Gather(Lookup<float>::RandVecs2D, hash, 1);
+    }
+
+    FNL_TARGET_SSE41 static void GradCoordDual(__m128i seed, __m128i xPrimed, __m128i yPrimed, __m128 xd, __m128 yd, __m128& xo, __m128& yo)
+    {
+        __m128i hash = Hash(seed, xPrimed, yPrimed);
+        __m128i index1 = _mm_and_si128(hash, _mm_set1_epi32(127 << 1));
+        __m128i index2 = _mm_and_si128(_mm_srai_epi32(hash, 7), _mm_set1_epi32(255 << 1));
+
+        __m128 xg = Gather(Lookup<float>::Gradients2D, index1, 0);
+        __m128 yg = Gather(Lookup<float>::Gradients2D, index1, 1);
+        __m128 value = _mm_add_ps(_mm_mul_ps(xd, xg), _mm_mul_ps(yd, yg));
+
+        xo = _mm_mul_ps(value, Gather(Lookup<float>::RandVecs2D, index2, 0));
+        yo = _mm_mul_ps(value, Gather(Lookup<float>::RandVecs2D, index2, 1));
+    }
+
+    FNL_TARGET_SSE41 static void AddWarpCorner(__m128 falloff, __m128i seed, __m128i xPrimed, __m128i yPrimed, __m128 xd, __m128 yd, bool outGradOnly, __m128& vx, __m128& vy)
+    {
+        __m128 xo, yo;
+        if (outGradOnly)
+            GradCoordOut(seed, xPrimed, yPrimed, xo, yo);
+        else
+            GradCoordDual(seed, xPrimed, yPrimed, xd, yd, xo, yo);
+
+        __m128 ff = _mm_mul_ps(falloff, falloff);
+        __m128 ffff = _mm_mul_ps(ff, ff);
+        __m128 inside = _mm_cmpgt_ps(falloff, _mm_setzero_ps());
+        vx = _mm_blendv_ps(vx, _mm_add_ps(vx, _mm_mul_ps(ffff, xo)), inside);
+        vy = _mm_blendv_ps(vy, _mm_add_ps(vy, _mm_mul_ps(ffff, yo)), inside);
+    }
+
+    FNL_TARGET_SSE41 static int SingleDomainWarpBasicGridSSE41(int seed, float warpAmp, float frequency, const float* xs, const float* ys, float* xr, float* yr, int count)
+    {
+        const __m128i vSeed = _mm_set1_epi32(seed);
+        const __m128i vPrimeX = _mm_set1_epi32(PrimeX);
+        const __m128i vPrimeY = _mm_set1_epi32(PrimeY);
+        const __m128i vMask = _mm_set1_epi32(255 << 1);
+        const __m128 vFrequency = _mm_set1_ps(frequency);
+        const __m128 vWarpAmp = _mm_set1_ps(warpAmp);
+        const float* randVecs = Lookup<float>::RandVecs2D;
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 xf = _mm_mul_ps(_mm_loadu_ps(xs + i), vFrequency);
+            __m128 yf = _mm_mul_ps(_mm_loadu_ps(ys + i), vFrequency);
+
+            __m128i x0 = FastFloor(xf);
+            __m128i y0 = FastFloor(yf);
+
+            __m128 xs0 = InterpHermite(_mm_sub_ps(xf, _mm_cvtepi32_ps(x0)));
+            __m128 ys0 = InterpHermite(_mm_sub_ps(yf, _mm_cvtepi32_ps(y0)));
+
+            x0 = _mm_mullo_epi32(x0, vPrimeX);
+            y0 = _mm_mullo_epi32(y0, vPrimeY);
+            __m128i x1 = _mm_add_epi32(x0, vPrimeX);
+            __m128i y1 = _mm_add_epi32(y0, vPrimeY);
+
+            __m128i hash0 = _mm_and_si128(Hash(vSeed, x0, y0), vMask);
+            __m128i hash1 = _mm_and_si128(Hash(vSeed, x1, y0), vMask);
+
+            __m128 lx0x = Lerp(Gather(randVecs, hash0, 0), Gather(randVecs, hash1, 0), xs0);
+            __m128 ly0x = Lerp(Gather(randVecs, hash0, 1), Gather(randVecs, hash1, 1), xs0);
+
+            hash0 = _mm_and_si128(Hash(vSeed, x0, y1), vMask);
+            hash1 = _mm_and_si128(Hash(vSeed, x1, y1), vMask);
+
+            __m128 lx1x = Lerp(Gather(randVecs, hash0, 0), Gather(randVecs, hash1, 0), xs0);
+            __m128 ly1x = Lerp(Gather(randVecs, hash0, 1), Gather(randVecs, hash1, 1), xs0);
+
+            _mm_storeu_ps(xr + i, _mm_add_ps(_mm_loadu_ps(xr + i), _mm_mul_ps(Lerp(lx0x, lx1x, ys0), vWarpAmp)));
+            _mm_storeu_ps(yr + i, _mm_add_ps(_mm_loadu_ps(yr + i), _mm_mul_ps(Lerp(ly0x, ly1x, ys0), vWarpAmp)));
+        }
+        return i;
+    }
+
+    FNL_TARGET_SSE41 static int SingleDomainWarpSimplexGradientSSE41(int seed, float warpAmp, float frequency, const float* xs, const float* ys, float* xr, float* yr, int count, bool outGradOnly)
+    {
+        const float SQRT3 = 1.7320508075688772935274463415059f;
+        const float G2 = (3 - SQRT3) / 6;
+
+        const __m128i vSeed = _mm_set1_epi32(seed);
+        const __m128i vPrimeX = _mm_set1_epi32(PrimeX);
+        const __m128i vPrimeY = _mm_set1_epi32(PrimeY);
+        const __m128 vFrequency = _mm_set1_ps(frequency);
+        const __m128 vWarpAmp = _mm_set1_ps(warpAmp);
+        const __m128 vG2 = _mm_set1_ps(G2);
+        const __m128 vG2m1 = _mm_set1_ps((float)G2 - 1);
+        const __m128 vHalf = _mm_set1_ps(0.5f);
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 x = _mm_mul_ps(_mm_loadu_ps(xs + i), vFrequency);
+            __m128 y = _mm_mul_ps(_mm_loadu_ps(ys + i), vFrequency);
+
+            __m128i xi0 = FastFloor(x);
+            __m128i yj0 = FastFloor(y);
+            __m128 xi = _mm_sub_ps(x, _mm_cvtepi32_ps(xi0));
+            __m128 yi = _mm_sub_ps(y, _mm_cvtepi32_ps(yj0));
+
+            __m128 t = _mm_mul_ps(_mm_add_ps(xi, yi), vG2);
+            __m128 x0 = _mm_sub_ps(xi, t);
+            __m128 y0 = _mm_sub_ps(yi, t);
+
+            __m128i ip = _mm_mullo_epi32(xi0, vPrimeX);
+            __m128i jp = _mm_mullo_epi32(yj0, vPrimeY);
+
+            __m128 vx = _mm_setzero_ps();
+            __m128 vy = _mm_setzero_ps();
+
+            __m128 a = _mm_sub_ps(_mm_sub_ps(vHalf, _mm_mul_ps(x0, x0)), _mm_mul_ps(y0, y0));
+            AddWarpCorner(a, vSeed, ip, jp, x0, y0, outGradOnly, vx, vy);
+
+            __m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps((float)(2 * (1 - 2 * G2) * (1 / G2 - 2))), t),
+                                  _mm_add_ps(_mm_set1_ps((float)(-2 * (1 - 2 * G2) * (1 - 2 * G2))), a));
+            __m128 x2 = _mm_add_ps(x0, _mm_set1_ps(2 * (float)G2 - 1));
+            __m128 y2 = _mm_add_ps(y0, _mm_set1_ps(2 * (float)G2 - 1));
+            AddWarpCorner(c, vSeed, _mm_add_epi32(ip, vPrimeX), _mm_add_epi32(jp, vPrimeY), x2, y2, outGradOnly, vx, vy);
+
+            __m128 upper = _mm_cmpgt_ps(y0, x0);
+            __m128i upperi = _mm_castps_si128(upper);
+            __m128 x1 = _mm_add_ps(x0, _mm_blendv_ps(vG2m1, vG2, upper));
+            __m128 y1 = _mm_add_ps(y0, _mm_blendv_ps(vG2, vG2m1, upper));
+            __m128i i1 = _mm_add_epi32(ip, _mm_andnot_si128(upperi, vPrimeX));
+            __m128i j1 = _mm_add_epi32(jp, _mm_and_si128(upperi, vPrimeY));
+            __m128 b = _mm_sub_ps(_mm_sub_ps(vHalf, _mm_mul_ps(x1, x1)), _mm_mul_ps(y1, y1));
+            AddWarpCorner(b, vSeed, i1, j1, x1, y1, outGradOnly, vx, vy);
+
+            _mm_storeu_ps(xr + i, _mm_add_ps(_mm_loadu_ps(xr + i), _mm_mul_ps(vx, vWarpAmp)));
+            _mm_storeu_ps(yr + i, _mm_add_ps(_mm_loadu_ps(yr + i), _mm_mul_ps(vy, vWarpAmp)));
+        }
+        return i;
+    }
+
+    FNL_TARGET_AVX2 static __m256 InterpHermite(__m256 t)
+    {
+        return _mm256_mul_ps(_mm256_mul_ps(t, t), _mm256_sub_ps(_mm256_set1_ps(3), _mm256_mul_ps(_mm256_set1_ps(2), t)));
+    }
+
+    FNL_TARGET_AVX2 static void GradCoordOut(__m256i seed, __m256i xPrimed, __m256i yPrimed, __m256& xo, __m256& yo)
+    {
+        __m256i hash = _mm256_and_si256(Hash(seed, xPrimed, yPrimed), _mm256_set1_epi32(255 << 1));
+
+        xo = _mm256_i32gather_ps(Lookup<float>::RandVecs2D, hash, 4);
+        yo = _mm256_i32gather_ps(Lookup<float>::RandVecs2D + 1, hash, 4);
+    }
+
+    FNL_TARGET_AVX2 static void GradCoordDual(__m256i seed, __m256i xPrimed, __m256i yPrimed, __m256 xd, __m256 yd, __m256& xo, __m256& yo)
+    {
+        __m256i hash = Hash(seed, xPrimed, yPrimed);
+        __m256i index1 = _mm256_and_si256(hash, _mm256_set1_epi32(127 << 1));
+        __m256i index2 = _mm256_and_si256(_mm256_srai_epi32(hash, 7), _mm256_set1_epi32(255 << 1));
+
+        __m256 xg = _mm256_i32gather_ps(Lookup<float>::Gradients2D, index1, 4);
+        __m256 yg = _mm256_i32gather_ps(Lookup<float>::Gradients2D + 1, index1, 4);
+        __m256 value = _mm256_add_ps(_mm256_mul_ps(xd, xg), _mm256_mul_ps(yd, yg));
+
+        xo = _mm256_mul_ps(value, _mm256_i32gather_ps(Lookup<float>::RandVecs2D, index2, 4));
+        yo = _mm256_mul_ps(value, _mm256_i32gather_ps(Lookup<float>::RandVecs2D + 1, index2, 4));
+    }
+
+    FNL_TARGET_AVX2 static void AddWarpCorner(__m256 falloff, __m256i seed, __m256i xPrimed, __m256i yPrimed, __m256 xd, __m256 yd, bool outGradOnly, __m256& vx, __m256& vy)
+    {
+        __m256 xo, yo;
+        if (outGradOnly)
+            GradCoordOut(seed, xPrimed, yPrimed, xo, yo);
+        else
+            GradCoordDual(seed, xPrimed, yPrimed, xd, yd, xo, yo);
+
+        __m256 ff = _mm256_mul_ps(falloff, falloff);
+        __m256 ffff = _mm256_mul_ps(ff, ff);
+        __m256 inside = _mm256_cmp_ps(falloff, _mm256_setzero_ps(), _CMP_GT_OQ);
+        vx = _mm256_blendv_ps(vx, _mm256_add_ps(vx, _mm256_mul_ps(ffff, xo)), inside);
+        vy = _mm256_blendv_ps(vy, _mm256_add_ps(vy, _mm256_mul_ps(ffff, yo)), inside);
+    }
+
+    FNL_TARGET_AVX2 static int SingleDomainWarpBasicGridAVX2(int seed, float warpAmp, float frequency, const float* xs, const float* ys, float* xr, float* yr, int count)
+    {
+        const __m256i vSeed = _mm256_set1_epi32(seed);
+        const __m256i vPrimeX = _mm256_set1_epi32(PrimeX);
+        const __m256i vPrimeY = _mm256_set1_epi32(PrimeY);
+        const __m256i vMask = _mm256_set1_epi32(255 << 1);
+        const __m256 vFrequency = _mm256_set1_ps(frequency);
+        const __m256 vWarpAmp = _mm256_set1_ps(warpAmp);
+        const float* randVecs = Lookup<float>::RandVecs2D;
+
+        int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 xf = _mm256_mul_ps(_mm256_loadu_ps(xs + i), vFrequency);
+            __m256 yf = _mm256_mul_ps(_mm256_loadu_ps(ys + i), vFrequency);
+
+            __m256i x0 = FastFloor(xf);
+            __m256i y0 = FastFloor(yf);
+
+            __m256 xs0 = InterpHermite(_mm256_sub_ps(xf, _mm256_cvtepi32_ps(x0)));
+            __m256 ys0 = InterpHermite(_mm256_sub_ps(yf, _mm256_cvtepi32_ps(y0)));
+
+            x0 = _mm256_mullo_epi32(x0, vPrimeX);
+            y0 = _mm256_mullo_epi32(y0, vPrimeY);
+            __m256i x1 = _mm256_add_epi32(x0, vPrimeX);
+            __m256i y1 = _mm256_add_epi32(y0, vPrimeY);
+
+            __m256i hash0 = _mm256_and_si256(Hash(vSeed, x0, y0), vMask);
+            __m256i hash1 = _mm256_and_si256(Hash(vSeed, x1, y0), vMask);
+
+            __m256 lx0x = Lerp(_mm256_i32gather_ps(randVecs, hash0, 4), _mm256_i32gather_ps(randVecs, hash1, 4), xs0);
+            __m256 ly0x = Lerp(_mm256_i32gather_ps(randVecs + 1, hash0, 4), _mm256_i32gather_ps(randVecs + 1, hash1, 4), xs0);
+
+            hash0 = _mm256_and_si256(Hash(vSeed, x0, y1), vMask);
+            hash1 = _mm256_and_si256(Hash(vSeed, x1, y1), vMask);
+
+            __m256 lx1x = Lerp(_mm256_i32gather_ps(randVecs, hash0, 4), _mm256_i32gather_ps(randVecs, hash1, 4), xs0);
+            __m256 ly1x = Lerp(_mm256_i32gather_ps(randVecs + 1, hash0, 4), _mm256_i32gather_ps(randVecs + 1, hash1, 4), xs0);
+
+            _mm256_storeu_ps(xr + i, _mm256_add_ps(_mm256_loadu_ps(xr + i), _mm256_mul_ps(Lerp(lx0x, lx1x, ys0), vWarpAmp)));
+            _mm256_storeu_ps(yr + i, _mm256_add_ps(_mm256_loadu_ps(yr + i), _mm256_mul_ps(Lerp(ly0x, ly1x, ys0), vWarpAmp)));
+        }
+        return i;
+    }
+
+    FNL_TARGET_AVX2 static int SingleDomainWarpSimplexGradientAVX2(int seed, float warpAmp, float frequency, const float* xs, const float* ys, float* xr, float* yr, int count, bool outGradOnly)
+    {
+        const float SQRT3 = 1.7320508075688772935274463415059f;
+        const float G2 = (3 - SQRT3) / 6;
+
+        const __m256i vSeed = _mm256_set1_epi32(seed);
+        const __m256i vPrimeX = _mm256_set1_epi32(PrimeX);
+        const __m256i vPrimeY = _mm256_set1_epi32(PrimeY);
+        const __m256 vFrequency = _mm256_set1_ps(frequency);
+        const __m256 vWarpAmp = _mm256_set1_ps(warpAmp);
+        const __m256 vG2 = _mm256_set1_ps(G2);
+        const __m256 vG2m1 = _mm256_set1_ps((float)G2 - 1);
+        const __m256 vHalf = _mm256_set1_ps(0.5f);
+
+        int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 x = _mm256_mul_ps(_mm256_loadu_ps(xs + i), vFrequency);
+            __m256 y = _mm256_mul_ps(_mm256_loadu_ps(ys + i), vFrequency);
+
+            __m256i xi0 = FastFloor(x);
+            __m256i yj0 = FastFloor(y);
+            __m256 xi = _mm256_sub_ps(x, _mm256_cvtepi32_ps(xi0));
+            __m256 yi = _mm256_sub_ps(y, _mm256_cvtepi32_ps(yj0));
+
+            __m256 t = _mm256_mul_ps(_mm256_add_ps(xi, yi), vG2);
+            __m256 x0 = _mm256_sub_ps(xi, t);
+            __m256 y0 = _mm256_sub_ps(yi, t);
+
+            __m256i ip = _mm256_mullo_epi32(xi0, vPrimeX);
+            __m256i jp = _mm256_mullo_epi32(yj0, vPrimeY);
+
+            __m256 vx = _mm256_setzero_ps();
+            __m256 vy = _mm256_setzero_ps();
+
+            __m256 a = _mm256_sub_ps(_mm256_sub_ps(vHalf, _mm256_mul_ps(x0, x0)), _mm256_mul_ps(y0, y0));
+            AddWarpCorner(a, vSeed, ip, jp, x0, y0, outGradOnly, vx, vy);
+
+            __m256 c = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps((float)(2 * (1 - 2 * G2) * (1 / G2 - 2))), t),
+                                     _mm256_add_ps(_mm256_set1_ps((float)(-2 * (1 - 2 * G2) * (1 - 2 * G2))), a));
+            __m256 x2 = _mm256_add_ps(x0, _mm256_set1_ps(2 * (float)G2 - 1));
+            __m256 y2 = _mm256_add_ps(y0, _mm256_set1_ps(2 * (float)G2 - 1));
+            AddWarpCorner(c, vSeed, _mm256_add_epi32(ip, vPrimeX), _mm256_add_epi32(jp, vPrimeY), x2, y2, outGradOnly, vx, vy);
+
+            __m256 upper = _mm256_cmp_ps(y0, x0, _CMP_GT_OQ);
+            __m256i upperi = _mm256_castps_si256(upper);
+            __m256 x1 = _mm256_add_ps(x0, _mm256_blendv_ps(vG2m1, vG2, upper));
+            __m256 y1 = _mm256_add_ps(y0, _mm256_blendv_ps(vG2, vG2m1, upper));
+            __m256i i1 = _mm256_add_epi32(ip, _mm256_andnot_si256(upperi, vPrimeX));
+            __m256i j1 = _mm256_add_epi32(jp, _mm256_and_si256(upperi, vPrimeY));
+            __m256 b = _mm256_sub_ps(_mm256_sub_ps(vHalf, _mm256_mul_ps(x1, x1)), _mm256_mul_ps(y1, y1));
+            AddWarpCorner(b, vSeed, i1, j1, x1, y1, outGradOnly, vx, vy);
+
+            _mm256_storeu_ps(xr + i, _mm256_add_ps(_mm256_loadu_ps(xr + i), _mm256_mul_ps(vx, vWarpAmp)));
+            _mm256_storeu_ps(yr + i, _mm256_add_ps(_mm256_loadu_ps(yr + i), _mm256_mul_ps(vy, vWarpAmp)));
+        }
+        return i;
+    }
+
+#endif
 };
 
 template <>
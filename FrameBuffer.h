@@ -0,0 +1,74 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <poll.h>
+#include <unistd.h>
+#include <vector>
+
+// Accumulates a whole frame of terminal output so it can be emitted with a
+// single write instead of one stream insertion per cell
+class FrameBuffer
+{
+public:
+    explicit FrameBuffer(std::size_t reserveBytes)
+    {
+        mData.reserve(reserveBytes);
+    }
+
+    void clear() { mData.clear(); }
+
+    void append(char c) { mData.push_back(c); }
+
+    void append(const char *s, std::size_t n) { mData.insert(mData.end(), s, s + n); }
+
+    void append(const char *s) { append(s, std::strlen(s)); }
+
+    void appendf(const char *format, ...)
+    {
+        char text[256];
+        va_list args;
+        va_start(args, format);
+        int n = std::vsnprintf(text, sizeof(text), format, args);
+        va_end(args);
+        if (n > 0)
+            append(text, std::min<std::size_t>(n, sizeof(text) - 1));
+    }
+
+    const char *data() const { return mData.data(); }
+    std::size_t size() const { return mData.size(); }
+
+    // Writes the buffered frame to fd, retrying partial writes; returns false on error
+    bool flush(int fd) const
+    {
+        std::size_t done = 0;
+        while (done < mData.size())
+        {
+            ssize_t n = ::write(fd, mData.data() + done, mData.size() - done);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                if (errno != EAGAIN && errno != EWOULDBLOCK)
+                    return false;
+                // a non-blocking terminal is full, sleep until it drains instead of spinning
+                pollfd writable = {fd, POLLOUT, 0};
+                if (poll(&writable, 1, -1) < 0 && errno != EINTR)
+                    return false;
+                continue;
+            }
+            done += (std::size_t)n;
+        }
+        return true;
+    }
+
+private:
+    std::vector<char> mData;
+};
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef PATROLS_H
+#define PATROLS_H
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Live patrols in structure-of-arrays form so the chase update runs over
+// contiguous floats, four patrols per step with SSE2.
+// Exhausted patrols are removed by moving the last patrol into their slot.
+// Positions before the latest update are kept for render interpolation.
+struct Patrols
+{
+    std::vector<float> wx, wy;
+    std::vector<float> prevWx, prevWy;
+    std::vector<float> stamina;
+
+    std::size_t size() const { return wx.size(); }
+
+    void spawn(float x, float y, float initialStamina)
+    {
+        wx.push_back(x);
+        wy.push_back(y);
+        prevWx.push_back(x);
+        prevWy.push_back(y);
+        stamina.push_back(initialStamina);
+    }
+
+    void remove(std::size_t i)
+    {
+        wx[i] = wx.back();
+        wy[i] = wy.back();
+        prevWx[i] = prevWx.back();
+        prevWy[i] = prevWy.back();
+        stamina[i] = stamina.back();
+        wx.pop_back();
+        wy.pop_back();
+        prevWx.pop_back();
+        prevWy.pop_back();
+        stamina.pop_back();
+    }
+
+    // Drops exhausted patrols, then moves the rest toward (cx, cy) and drains their stamina
+    void update(float cx, float cy, float speed, float dt)
+    {
+        for (std::size_t i = 0; i < size();)
+        {
+            if (stamina[i] <= 0.0f)
+                remove(i);
+            else
+                ++i;
+        }
+
+        prevWx = wx;
+        prevWy = wy;
+
+        std::size_t n = size();
+        float *px = wx.data();
+        float *py = wy.data();
+        float *ps = stamina.data();
+        std::size_t i = 0;
+
+#if defined(__SSE2__)
+        const __m128 vcx = _mm_set1_ps(cx);
+        const __m128 vcy = _mm_set1_ps(cy);
+        const __m128 vspeed = _mm_set1_ps(speed);
+        const __m128 vdt = _mm_set1_ps(dt);
+        const __m128 vmin = _mm_set1_ps(0.001f);
+
+        for (; i + 4 <= n; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(px + i);
+            __m128 y = _mm_loadu_ps(py + i);
+            __m128 vx = _mm_sub_ps(vcx, x);
+            __m128 vy = _mm_sub_ps(vcy, y);
+            __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)));
+            __m128 moving = _mm_cmpgt_ps(len, vmin);
+            len = _mm_max_ps(len, vmin);
+            __m128 mx = _mm_add_ps(x, _mm_mul_ps(_mm_mul_ps(_mm_div_ps(vx, len), vspeed), vdt));
+            __m128 my = _mm_add_ps(y, _mm_mul_ps(_mm_mul_ps(_mm_div_ps(vy, len), vspeed), vdt));
+            _mm_storeu_ps(px + i, _mm_or_ps(_mm_and_ps(moving, mx), _mm_andnot_ps(moving, x)));
+            _mm_storeu_ps(py + i, _mm_or_ps(_mm_and_ps(moving, my), _mm_andnot_ps(moving, y)));
+            _mm_storeu_ps(ps + i, _mm_sub_ps(_mm_loadu_ps(ps + i), vdt));
+        }
+#endif
+
+        // the chase step as the game has always computed it, vx / len * speed * dt; the vector
+        // loop evaluates it in the same order, which gives the same bits while multiply-adds
+        // are not fused (the build passes -ffp-contract=off)
+        for (; i < n; ++i)
+        {
+            float vx = cx - px[i];
+            float vy = cy - py[i];
+            float len = std::sqrt(vx * vx + vy * vy);
+            // patrols standing on the target do not move
+            if (len > 0.001f)
+            {
+                px[i] += vx / len * speed * dt;
+                py[i] += vy / len * speed * dt;
+            }
+            ps[i] -= dt;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <random>
+#include "Patrols.h"
+
+// Movement keys considered held during a tick
+struct MoveInput
+{
+    bool up, down, left, right, run;
+};
+
+// Game state advanced in fixed time steps, independent of how often or how
+// slowly frames are drawn. Given the same seed and inputs it replays exactly.
+struct Simulation
+{
+    static constexpr float WalkSpeed = 1.5f;
+    static constexpr float RunSpeed = 5.0f;
+    static constexpr float PatrolSpeed = 4.2f;
+    static constexpr float PatrolStamina = 20.0f;
+
+    float cx = 0.0f, cy = 0.0f;
+    float prevCx = 0.0f, prevCy = 0.0f; // player position before the latest tick
+    Patrols patrols;
+
+    std::mt19937 rng;
+    std::uniform_real_distribution<float> spawnDist{-15.0f, 15.0f};
+    std::uniform_real_distribution<float> timeDist{5.0f, 12.0f};
+    float nextSpawnTime;
+    float spawnTimer = 0.0f;
+
+    explicit Simulation(unsigned seed)
+        : rng(seed)
+    {
+        nextSpawnTime = timeDist(rng);
+    }
+
+    static float speedFor(const MoveInput &input)
+    {
+        return input.run ? RunSpeed : WalkSpeed;
+    }
+
+    // unit steps along each axis for the held keys, opposite keys cancel
+    static void direction(const MoveInput &input, float &dx, float &dy)
+    {
+        dx = (input.right ? 1.0f : 0.0f) - (input.left ? 1.0f : 0.0f);
+        dy = (input.down ? 1.0f : 0.0f) - (input.up ? 1.0f : 0.0f);
+    }
+
+    // True when further ticks only count down to the next spawn: nothing is
+    // moving and the last tick left the player where it was
+    bool idle(const MoveInput &input) const
+    {
+        bool moving = input.up || input.down || input.left || input.right;
+        return !moving && patrols.size() == 0 && cx == prevCx && cy == prevCy;
+    }
+
+    float timeUntilSpawn() const { return nextSpawnTime - spawnTimer; }
+
+    void tick(float dt, const MoveInput &input)
+    {
+        prevCx = cx;
+        prevCy = cy;
+
+        float dx, dy;
+        direction(input, dx, dy);
+        float speed = speedFor(input);
+        cx += dx * speed * dt;
+        cy += dy * speed * dt;
+
+        spawnTimer += dt;
+        if (spawnTimer >= nextSpawnTime)
+        {
+            spawnTimer = 0;
+            nextSpawnTime = timeDist(rng);
+            float px = cx + spawnDist(rng);
+            float py = cy + spawnDist(rng);
+            patrols.spawn(px, py, PatrolStamina);
+        }
+
+        patrols.update(cx, cy, PatrolSpeed, dt);
+    }
+};
+
+#endif
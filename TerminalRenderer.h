@@ -0,0 +1,147 @@
+#ifndef TERMINALRENDERER_H
+#define TERMINALRENDERER_H
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "FrameBuffer.h"
+
+// Draws a width x height character grid plus a status line, sending only the
+// cells that changed since the previous frame. Falls back to a full redraw
+// when too much of the screen changed for cursor addressing to pay off.
+class TerminalRenderer
+{
+public:
+    // fd -1 composes frames without sending them anywhere, for headless runs
+    TerminalRenderer(int width, int height, int fd)
+        : mWidth(width),
+          mHeight(height),
+          mFd(fd),
+          mCells(width * height, ' '),
+          mPrevious(width * height, ' '),
+          mFullRedraw(true),
+          mFullRedrawThreshold(0.5f),
+          mFrame((width + 8) * height * 2 + 256),
+          mLastBytes(0)
+    {
+    }
+
+    int width() const { return mWidth; }
+    int height() const { return mHeight; }
+
+    // grid for the next frame, row-major, filled by the caller before present()
+    char *cells() { return mCells.data(); }
+
+    void setStatus(const char *format, ...)
+    {
+        char text[256];
+        va_list args;
+        va_start(args, format);
+        std::vsnprintf(text, sizeof(text), format, args);
+        va_end(args);
+        mStatus = text;
+    }
+
+    // fraction of changed cells above which the whole screen is redrawn
+    void setFullRedrawThreshold(float fraction) { mFullRedrawThreshold = fraction; }
+
+    // forget what the terminal shows, e.g. after a resize
+    void invalidate() { mFullRedraw = true; }
+
+    void present()
+    {
+        int total = mWidth * mHeight;
+        int changed = 0;
+        for (int i = 0; i < total; ++i)
+            changed += mCells[i] != mPrevious[i];
+
+        mFrame.clear();
+        if (mFullRedraw || changed > total * mFullRedrawThreshold)
+            encodeFull();
+        else
+            encodeDiff();
+
+        mLastBytes = mFrame.size();
+        if (mFrame.size() && mFd >= 0)
+            mFrame.flush(mFd);
+
+        mPrevious = mCells;
+        mPreviousStatus = mStatus;
+        mFullRedraw = false;
+    }
+
+    void clearScreen()
+    {
+        mFrame.clear();
+        mFrame.append("\033[H\033[J");
+        if (mFd >= 0)
+            mFrame.flush(mFd);
+        mFullRedraw = true;
+    }
+
+    // bytes sent by the last present()
+    std::size_t lastBytes() const { return mLastBytes; }
+
+private:
+    // a run of unchanged cells shorter than this is resent instead of skipped with a cursor move
+    static const int MaxResendGap = 4;
+
+    void encodeFull()
+    {
+        mFrame.append("\033[H");
+        for (int y = 0; y < mHeight; ++y)
+        {
+            mFrame.append(&mCells[y * mWidth], mWidth);
+            mFrame.append("\033[K\n");
+        }
+        mFrame.append(mStatus.data(), mStatus.size());
+        mFrame.append("\033[K\n\033[J");
+    }
+
+    void encodeDiff()
+    {
+        for (int y = 0; y < mHeight; ++y)
+        {
+            const char *row = &mCells[y * mWidth];
+            const char *previousRow = &mPrevious[y * mWidth];
+            int cursor = -1; // column the terminal cursor sits at within this row, -1 if elsewhere
+
+            for (int x = 0; x < mWidth; ++x)
+            {
+                if (row[x] == previousRow[x])
+                    continue;
+
+                if (cursor >= 0 && x - cursor <= MaxResendGap)
+                    mFrame.append(row + cursor, x - cursor);
+                else
+                    mFrame.appendf("\033[%d;%dH", y + 1, x + 1);
+
+                mFrame.append(row[x]);
+                cursor = x + 1;
+            }
+        }
+
+        if (mStatus != mPreviousStatus)
+        {
+            mFrame.appendf("\033[%d;1H", mHeight + 1);
+            mFrame.append(mStatus.data(), mStatus.size());
+            mFrame.append("\033[K");
+        }
+    }
+
+    int mWidth;
+    int mHeight;
+    int mFd;
+    std::vector<char> mCells;
+    std::vector<char> mPrevious;
+    std::string mStatus;
+    std::string mPreviousStatus;
+    bool mFullRedraw;
+    float mFullRedrawThreshold;
+    FrameBuffer mFrame;
+    std::size_t mLastBytes;
+};
+
+#endif
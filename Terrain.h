@@ -0,0 +1,204 @@
+#ifndef TERRAIN_H
+#define TERRAIN_H
+
+#include <cmath>
+#include <cstdint>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "FastNoise.h"
+
+// Terrain is generated and cached in square chunks of ChunkSize x ChunkSize cells
+const int ChunkSize = 32;
+const int ChunkShift = 5;
+
+// One chunk of noise quantized to an 8-bit level per cell (see SymbolTable),
+// a quarter of the float output. Levels keep enough of the noise that the
+// bands can be changed without regenerating; this is what the chunk store keeps.
+struct TerrainChunk
+{
+    uint8_t levels[ChunkSize * ChunkSize];
+};
+
+// One chunk reduced to the band of each cell, two 4-bit bands per byte (even
+// cells in the low nibble), an eighth of the float output. Only valid for the
+// SymbolTable that packed it; this is what the terrain cache keeps.
+struct PackedChunk
+{
+    uint8_t bands[ChunkSize * ChunkSize / 2];
+};
+
+// Noise bands and the symbol drawn for each: values below thresholds[0] get
+// symbols[0], values from thresholds[i - 1] up to thresholds[i] get symbols[i]
+// and anything from the last threshold up gets symbols[Bands - 1]
+struct TerrainConfig
+{
+    static const int Bands = 5;
+
+    float thresholds[Bands - 1];
+    char symbols[Bands];
+    char reserved[3];
+
+    static TerrainConfig defaults()
+    {
+        return {{-0.3f, 0.0f, 0.3f, 0.6f}, {'.', ':', '*', '#', '@'}, {}};
+    }
+
+    // Whether the bands can be drawn: finite thresholds in strictly ascending order and
+    // printable symbols, so a damaged or crafted file cannot write control bytes to the terminal
+    bool valid() const
+    {
+        for (int i = 0; i < Bands - 1; ++i)
+        {
+            if (!std::isfinite(thresholds[i]) || (i > 0 && !(thresholds[i] > thresholds[i - 1])))
+                return false;
+        }
+        for (int i = 0; i < Bands; ++i)
+        {
+            if (symbols[i] < 0x20 || symbols[i] > 0x7e)
+                return false;
+        }
+        return true;
+    }
+};
+
+// Maps noise values to symbols without branching: a value is quantized to one
+// of Levels fixed-point steps of 1/Scale, and the step indexes a table built
+// from the thresholds. A threshold takes effect from the step it falls in, so
+// the values below it in that step (less than a step, 1/120) get the upper band.
+// Value 0 is a step edge and the steps are 1/120 wide, so thresholds on a
+// multiple of 1/120, which includes the default bands, start their step
+// exactly and every value gets the band the thresholds give it.
+class SymbolTable
+{
+public:
+    static const int Levels = 256;
+
+    explicit SymbolTable(const TerrainConfig &config = TerrainConfig::defaults())
+    {
+        for (int level = 0; level < Levels; ++level)
+        {
+            int band = 0;
+            while (band < TerrainConfig::Bands - 1 && level >= SymbolTable::level(config.thresholds[band]))
+                ++band;
+            mBand[level] = (uint8_t)band;
+            mTable[level] = config.symbols[band];
+        }
+        for (int band = 0; band < TerrainConfig::Bands; ++band)
+            mSymbols[band] = config.symbols[band];
+    }
+
+    // the step a noise value falls in, clamped to the table; rounded down before
+    // Bias is added, so no second rounding can move a value across a step edge
+    static uint8_t level(float v)
+    {
+        float f = v * Scale;
+        f = f > -Bias ? f : -Bias;
+        f = f < Levels - 1 - Bias ? f : Levels - 1 - Bias;
+        int step = (int)f;
+        step -= (float)step > f;
+        return (uint8_t)(step + Bias);
+    }
+
+    // the noise value at the centre of a step
+    static float value(int level) { return (level - Bias + 0.5f) / Scale; }
+
+    // Quantizes a whole buffer of noise values, sixteen at a time with SSE2
+    static void quantize(const float *values, uint8_t *levels, int count)
+    {
+        int i = 0;
+#if defined(__SSE2__)
+        const __m128 scale = _mm_set1_ps(Scale);
+        const __m128 low = _mm_set1_ps((float)-Bias);
+        const __m128 high = _mm_set1_ps((float)(Levels - 1 - Bias));
+        const __m128i bias = _mm_set1_epi32(Bias);
+        auto steps = [&](const float *v)
+        {
+            __m128 f = _mm_mul_ps(_mm_loadu_ps(v), scale);
+            f = _mm_min_ps(_mm_max_ps(f, low), high);
+            __m128i step = _mm_cvttps_epi32(f);
+            // truncation rounds negative steps up, the compare mask is -1 where it did
+            step = _mm_add_epi32(step, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(step), f)));
+            return _mm_add_epi32(step, bias);
+        };
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i first = _mm_packs_epi32(steps(values + i), steps(values + i + 4));
+            __m128i second = _mm_packs_epi32(steps(values + i + 8), steps(values + i + 12));
+            _mm_storeu_si128((__m128i *)(levels + i), _mm_packus_epi16(first, second));
+        }
+#endif
+        for (; i < count; ++i)
+            levels[i] = level(values[i]);
+    }
+
+    // Turns levels back into the noise value at the centre of each step
+    static void dequantize(const uint8_t *levels, float *values, int count)
+    {
+        for (int i = 0; i < count; ++i)
+            values[i] = value(levels[i]);
+    }
+
+    char symbol(uint8_t level) const { return mTable[level]; }
+    char symbol(float v) const { return mTable[level(v)]; }
+
+    void pack(const TerrainChunk &chunk, PackedChunk &packed) const
+    {
+        for (int i = 0; i < ChunkSize * ChunkSize / 2; ++i)
+            packed.bands[i] = (uint8_t)(mBand[chunk.levels[2 * i]] | mBand[chunk.levels[2 * i + 1]] << 4);
+    }
+
+    // Writes the symbols of count cells of a packed chunk, starting at cell index first
+    void unpack(const PackedChunk &packed, int first, int count, char *symbols) const
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            int cell = first + i;
+            symbols[i] = mSymbols[(packed.bands[cell >> 1] >> ((cell & 1) * 4)) & 0xF];
+        }
+    }
+
+    // Quantizes a buffer of noise values and looks up the symbol for each
+    void apply(const float *values, char *symbols, int count) const
+    {
+        uint8_t levels[256];
+        for (int start = 0; start < count; start += 256)
+        {
+            int n = count - start < 256 ? count - start : 256;
+            quantize(values + start, levels, n);
+            for (int i = 0; i < n; ++i)
+                symbols[start + i] = mTable[levels[i]];
+        }
+    }
+
+private:
+    static constexpr float Scale = 120.0f; // steps per unit of noise, 0.1 is 12 steps
+    static const int Bias = 128;            // level of the step starting at 0
+
+    uint8_t mBand[Levels];
+    char mTable[Levels]; // symbol of each level, mSymbols[mBand[level]]
+    char mSymbols[16] = {};
+};
+
+static_assert(TerrainConfig::Bands <= 16, "a band has to fit in the 4 bits of a PackedChunk cell");
+
+// chunk coordinate containing a cell coordinate, rounding toward negative infinity
+inline int chunkOf(int cell)
+{
+    return cell >= 0 ? cell >> ChunkShift : ~(~cell >> ChunkShift);
+}
+
+// packs a chunk coordinate into a single hashable key
+inline std::uint64_t chunkKey(int chunkX, int chunkY)
+{
+    return ((std::uint64_t)(std::uint32_t)chunkX << 32) | (std::uint32_t)chunkY;
+}
+
+inline void generateChunk(const NoiseGenerator &noise, int chunkX, int chunkY, TerrainChunk &chunk)
+{
+    float values[ChunkSize * ChunkSize];
+    noise.GenGrid2D(values, chunkX * ChunkSize, chunkY * ChunkSize, ChunkSize, ChunkSize);
+    SymbolTable::quantize(values, chunk.levels, ChunkSize * ChunkSize);
+}
+
+#endif
@@ -0,0 +1,187 @@
+#ifndef TERRAINCACHE_H
+#define TERRAINCACHE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include "ChunkStore.h"
+#include "Terrain.h"
+
+// Keeps generated terrain chunks around the camera, evicting the least
+// recently used chunk once the configured memory cap is reached. Chunks are
+// held packed to 4 bits per cell, so the cap covers twice the area of chars.
+// Safe to fill from the render thread while prefetch workers add chunks.
+// Every chunk comes in through produce(), so none can bypass the store.
+// With a store, chunks not in memory are read back from it before being
+// generated, and every generated chunk is added to it.
+class TerrainCache
+{
+public:
+    TerrainCache(const NoiseGenerator &noise, const SymbolTable &symbols, std::size_t maxBytes,
+                 ChunkStore *store = nullptr)
+        : mNoise(noise),
+          mSymbols(symbols),
+          mStore(store),
+          mMaxChunks(std::max<std::size_t>(1, maxBytes / sizeof(Entry))),
+          mGenerated(0),
+          mLoaded(0),
+          mMissed(0)
+    {
+    }
+
+    const NoiseGenerator &noise() const { return mNoise; }
+
+    bool contains(int chunkX, int chunkY) const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mChunks.count(chunkKey(chunkX, chunkY)) != 0;
+    }
+
+    // Makes sure a chunk is cached, from the store or by generating it on the calling thread
+    void prefetch(int chunkX, int chunkY)
+    {
+        if (contains(chunkX, chunkY))
+            return;
+        PackedChunk packed;
+        produce(chunkX, chunkY, packed);
+        std::lock_guard<std::mutex> lock(mMutex);
+        insertLocked(chunkKey(chunkX, chunkY), packed);
+    }
+
+    // Copies the symbols of a width x height cell rectangle into a row-major buffer,
+    // generating any chunk that is not cached yet on the calling thread
+    void fillView(char *out, int x0, int y0, int width, int height)
+    {
+        int x1 = x0 + width;
+        int y1 = y0 + height;
+
+        for (int chunkY = chunkOf(y0); chunkY <= chunkOf(y1 - 1); ++chunkY)
+        {
+            for (int chunkX = chunkOf(x0); chunkX <= chunkOf(x1 - 1); ++chunkX)
+            {
+                int cellX = chunkX * ChunkSize;
+                int cellY = chunkY * ChunkSize;
+                int fromX = std::max(x0, cellX);
+                int toX = std::min(x1, cellX + ChunkSize);
+                int fromY = std::max(y0, cellY);
+                int toY = std::min(y1, cellY + ChunkSize);
+
+                std::uint64_t key = chunkKey(chunkX, chunkY);
+                std::unique_lock<std::mutex> lock(mMutex);
+                const PackedChunk *chunk = findLocked(key);
+                if (!chunk)
+                {
+                    lock.unlock();
+                    PackedChunk produced;
+                    produce(chunkX, chunkY, produced);
+                    lock.lock();
+                    ++mMissed;
+                    chunk = insertLocked(key, produced);
+                }
+
+                for (int y = fromY; y < toY; ++y)
+                {
+                    mSymbols.unpack(*chunk, (y - cellY) * ChunkSize + (fromX - cellX), toX - fromX,
+                                    out + (y - y0) * width + (fromX - x0));
+                }
+            }
+        }
+    }
+
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mChunks.size();
+    }
+
+    std::size_t capacity() const { return mMaxChunks; }
+
+    // chunks generated in total, chunks read back from the store, and the
+    // chunks fillView had to produce itself on a cache miss
+    std::size_t generatedChunks() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mGenerated;
+    }
+
+    std::size_t loadedChunks() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mLoaded;
+    }
+
+    std::size_t missedChunks() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mMissed;
+    }
+
+private:
+    struct Entry
+    {
+        PackedChunk chunk;
+        std::list<std::uint64_t>::iterator lru;
+    };
+
+    // Reads a chunk from the store or generates and stores it, then packs it; without holding the lock
+    void produce(int chunkX, int chunkY, PackedChunk &packed)
+    {
+        TerrainChunk chunk;
+        bool loaded = mStore && mStore->read(chunkX, chunkY, chunk);
+        if (!loaded)
+        {
+            generateChunk(mNoise, chunkX, chunkY, chunk);
+            if (mStore)
+                mStore->write(chunkX, chunkY, chunk);
+        }
+        mSymbols.pack(chunk, packed);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (loaded)
+            ++mLoaded;
+        else
+            ++mGenerated;
+    }
+
+    const PackedChunk *findLocked(std::uint64_t key)
+    {
+        auto it = mChunks.find(key);
+        if (it == mChunks.end())
+            return nullptr;
+        mLru.splice(mLru.begin(), mLru, it->second.lru);
+        return &it->second.chunk;
+    }
+
+    const PackedChunk *insertLocked(std::uint64_t key, const PackedChunk &chunk)
+    {
+        if (const PackedChunk *existing = findLocked(key))
+            return existing;
+
+        if (mChunks.size() >= mMaxChunks)
+        {
+            mChunks.erase(mLru.back());
+            mLru.pop_back();
+        }
+
+        mLru.push_front(key);
+        Entry &entry = mChunks[key];
+        entry.chunk = chunk;
+        entry.lru = mLru.begin();
+        return &entry.chunk;
+    }
+
+    const NoiseGenerator &mNoise;
+    SymbolTable mSymbols;
+    ChunkStore *mStore;
+    std::size_t mMaxChunks;
+    std::size_t mGenerated;
+    std::size_t mLoaded;
+    std::size_t mMissed;
+    std::list<std::uint64_t> mLru; // most recently used first
+    std::unordered_map<std::uint64_t, Entry> mChunks;
+    mutable std::mutex mMutex;
+};
+
+#endif
@@ -0,0 +1,278 @@
+#ifndef UNIVERSE_H
+#define UNIVERSE_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "FastNoiseLite.h"
+#include "Simulation.h"
+#include "Terrain.h"
+
+// Noise settings a universe's terrain is generated from
+struct NoiseConfig
+{
+    static const int32_t MaxOctaves = 16;
+
+    int32_t seed;
+    int32_t noiseType;
+    float frequency;
+    int32_t fractalType;
+    int32_t octaves;
+    float lacunarity;
+    float gain;
+    float weightedStrength;
+    float pingPongStrength;
+    int32_t cellularDistance;
+    int32_t cellularReturn;
+    float cellularJitter;
+
+    // the terrain the game has always used, with the given seed
+    static NoiseConfig defaults(int32_t seed)
+    {
+        NoiseConfig config;
+        config.seed = seed;
+        config.noiseType = FastNoiseLite::NoiseType_Perlin;
+        config.frequency = 0.05f;
+        config.fractalType = FastNoiseLite::FractalType_None;
+        config.octaves = 3;
+        config.lacunarity = 2.0f;
+        config.gain = 0.5f;
+        config.weightedStrength = 0.0f;
+        config.pingPongStrength = 2.0f;
+        config.cellularDistance = FastNoiseLite::CellularDistanceFunction_EuclideanSq;
+        config.cellularReturn = FastNoiseLite::CellularReturnType_Distance;
+        config.cellularJitter = 1.0f;
+        return config;
+    }
+
+    // Whether every field is one the noise can be generated from; a damaged or
+    // hostile file could otherwise ask for billions of octaves or an unknown type
+    bool valid() const
+    {
+        return noiseType >= 0 && noiseType <= FastNoiseLite::NoiseType_Value &&
+               fractalType >= 0 && fractalType <= FastNoiseLite::FractalType_DomainWarpIndependent &&
+               cellularDistance >= 0 && cellularDistance <= FastNoiseLite::CellularDistanceFunction_Hybrid &&
+               cellularReturn >= 0 && cellularReturn <= FastNoiseLite::CellularReturnType_Distance2Div &&
+               octaves >= 1 && octaves <= MaxOctaves &&
+               std::isfinite(frequency) && frequency != 0.0f &&
+               std::isfinite(lacunarity) && std::isfinite(gain) && std::isfinite(weightedStrength) &&
+               std::isfinite(pingPongStrength) && std::isfinite(cellularJitter);
+    }
+
+    void apply(FastNoiseLite &noise) const
+    {
+        noise.SetSeed(seed);
+        noise.SetNoiseType((FastNoiseLite::NoiseType)noiseType);
+        noise.SetFrequency(frequency);
+        noise.SetFractalType((FastNoiseLite::FractalType)fractalType);
+        noise.SetFractalOctaves(octaves);
+        noise.SetFractalLacunarity(lacunarity);
+        noise.SetFractalGain(gain);
+        noise.SetFractalWeightedStrength(weightedStrength);
+        noise.SetFractalPingPongStrength(pingPongStrength);
+        noise.SetCellularDistanceFunction((FastNoiseLite::CellularDistanceFunction)cellularDistance);
+        noise.SetCellularReturnType((FastNoiseLite::CellularReturnType)cellularReturn);
+        noise.SetCellularJitter(cellularJitter);
+    }
+};
+
+// Fixed-layout start of a universe file, everything needed to list a universe
+// or to regenerate its terrain. Followed by patrolCount (x, y, stamina)
+// triples and rngWords words of random engine state.
+struct UniverseHeader
+{
+    static constexpr char Magic[8] = {'N', 'X', 'U', 'N', 'I', 'V', '\0', '\0'};
+    static const uint32_t CurrentVersion = 1;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    NoiseConfig noise;
+
+    // player and spawn clock
+    float cx, cy;
+    float spawnTimer, nextSpawnTime;
+    uint32_t patrolCount;
+    uint32_t rngWords;
+
+    TerrainConfig terrain;
+
+    // Reads and checks the header at the start of an open universe file.
+    bool read(int fd)
+    {
+        std::memset(this, 0, sizeof(*this));
+        if (pread(fd, this, sizeof(*this), 0) != (ssize_t)sizeof(*this))
+            return false;
+        if (std::memcmp(magic, Magic, sizeof(magic)) != 0)
+            return false;
+        if (version != CurrentVersion || headerSize != sizeof(*this))
+            return false;
+        return true;
+    }
+};
+
+static_assert(sizeof(UniverseHeader) == 112, "universe header layout changed, bump its version");
+
+// A saved world: its noise configuration plus the simulation state to resume.
+// Files are rewritten whole through a temporary and a rename, so a crash while
+// saving leaves the previous save intact.
+class Universe
+{
+public:
+    // bounds on the variable-length tail, so a damaged file cannot ask for gigabytes
+    static const uint32_t MaxPatrols = 1 << 16;
+    static const uint32_t MaxRngWords = 4096;
+
+    Universe()
+    {
+        std::memset(&mHeader, 0, sizeof(mHeader));
+        std::memcpy(mHeader.magic, UniverseHeader::Magic, sizeof(mHeader.magic));
+        mHeader.version = UniverseHeader::CurrentVersion;
+        mHeader.headerSize = sizeof(UniverseHeader);
+    }
+
+    // a fresh universe with the default terrain settings
+    explicit Universe(int32_t seed)
+        : Universe()
+    {
+        mHeader.noise = NoiseConfig::defaults(seed);
+        mHeader.terrain = TerrainConfig::defaults();
+    }
+
+    const UniverseHeader &header() const { return mHeader; }
+    const NoiseConfig &noise() const { return mHeader.noise; }
+    const TerrainConfig &terrain() const { return mHeader.terrain; }
+
+    // Identifies the noise this configuration generates, stored chunks are only
+    // reused while it matches. The bands are left out: chunks are stored as
+    // noise levels, so they can be redrawn with other thresholds.
+    uint64_t terrainFingerprint() const
+    {
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](const void *data, std::size_t size)
+        {
+            const unsigned char *bytes = (const unsigned char *)data;
+            for (std::size_t i = 0; i < size; ++i)
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+        };
+        mix(&mHeader.noise, sizeof(mHeader.noise));
+        return hash;
+    }
+
+    // the seed the simulation's random engine starts from in a new universe
+    unsigned simulationSeed() const { return (unsigned)mHeader.noise.seed; }
+
+    bool load(const std::string &path)
+    {
+        std::FILE *file = std::fopen(path.c_str(), "rb");
+        if (!file)
+            return false;
+
+        UniverseHeader header;
+        bool ok = header.read(fileno(file)) && header.noise.valid() && header.terrain.valid() &&
+                  std::fseek(file, sizeof(header), SEEK_SET) == 0 &&
+                  header.patrolCount <= MaxPatrols && header.rngWords <= MaxRngWords;
+
+        std::vector<float> patrols;
+        std::vector<uint32_t> rng;
+        if (ok)
+        {
+            patrols.resize(header.patrolCount * 3);
+            rng.resize(header.rngWords);
+            ok = std::fread(patrols.data(), sizeof(float), patrols.size(), file) == patrols.size() &&
+                 std::fread(rng.data(), sizeof(uint32_t), rng.size(), file) == rng.size();
+        }
+        std::fclose(file);
+        if (!ok)
+            return false;
+
+        mHeader = header;
+        mPatrols.swap(patrols);
+        mRng.swap(rng);
+        return true;
+    }
+
+    bool save(const std::string &path) const
+    {
+        std::string temporary = path + ".tmp";
+        std::FILE *file = std::fopen(temporary.c_str(), "wb");
+        if (!file)
+            return false;
+
+        bool ok = std::fwrite(&mHeader, sizeof(mHeader), 1, file) == 1 &&
+                  std::fwrite(mPatrols.data(), sizeof(float), mPatrols.size(), file) == mPatrols.size() &&
+                  std::fwrite(mRng.data(), sizeof(uint32_t), mRng.size(), file) == mRng.size();
+        ok = std::fflush(file) == 0 && ok;
+        ok = fsync(fileno(file)) == 0 && ok;
+        ok = std::fclose(file) == 0 && ok;
+
+        if (!ok || std::rename(temporary.c_str(), path.c_str()) != 0)
+        {
+            std::remove(temporary.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    // Records the simulation's state for the next save
+    void capture(const Simulation &sim)
+    {
+        mHeader.cx = sim.cx;
+        mHeader.cy = sim.cy;
+        mHeader.spawnTimer = sim.spawnTimer;
+        mHeader.nextSpawnTime = sim.nextSpawnTime;
+
+        const Patrols &patrols = sim.patrols;
+        mHeader.patrolCount = (uint32_t)patrols.size();
+        mPatrols.clear();
+        for (std::size_t i = 0; i < patrols.size(); ++i)
+        {
+            mPatrols.push_back(patrols.wx[i]);
+            mPatrols.push_back(patrols.wy[i]);
+            mPatrols.push_back(patrols.stamina[i]);
+        }
+
+        // the engine only exposes its state as text, a list of integers
+        std::stringstream state;
+        state << sim.rng;
+        mRng.clear();
+        uint32_t word;
+        while (state >> word)
+            mRng.push_back(word);
+        mHeader.rngWords = (uint32_t)mRng.size();
+    }
+
+    // Puts a simulation back in the captured state; a universe that was never
+    // played leaves it as constructed from simulationSeed()
+    void restore(Simulation &sim) const
+    {
+        if (mRng.empty())
+            return;
+
+        sim.cx = sim.prevCx = mHeader.cx;
+        sim.cy = sim.prevCy = mHeader.cy;
+        sim.spawnTimer = mHeader.spawnTimer;
+        sim.nextSpawnTime = mHeader.nextSpawnTime;
+
+        sim.patrols = Patrols();
+        for (std::size_t i = 0; i + 2 < mPatrols.size(); i += 3)
+            sim.patrols.spawn(mPatrols[i], mPatrols[i + 1], mPatrols[i + 2]);
+
+        std::stringstream state;
+        for (uint32_t word : mRng)
+            state << word << ' ';
+        state >> sim.rng;
+    }
+
+private:
+    UniverseHeader mHeader;
+    std::vector<float> mPatrols; // x, y, stamina per patrol
+    std::vector<uint32_t> mRng;
+};
+
+#endif
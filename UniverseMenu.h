@@ -0,0 +1,323 @@
+#ifndef UNIVERSEMENU_H
+#define UNIVERSEMENU_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <fcntl.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include "EventLoop.h"
+#include "FrameBuffer.h"
+#include "Universe.h"
+
+// The universe files in one directory. Scanning only lists file names; each
+// universe's fixed-layout header is read with a single pread the first time
+// the entry is looked at, so opening a directory of hundreds of saves costs
+// one readdir pass and nothing is parsed beyond what is on screen.
+class UniverseDirectory
+{
+public:
+    static constexpr const char *Extension = ".nxu";
+
+    struct Entry
+    {
+        std::string name; // file name without the extension
+        bool read = false;
+        bool valid = false;
+        time_t modified = 0;
+        UniverseHeader header;
+    };
+
+    explicit UniverseDirectory(std::string path)
+        : mPath(std::move(path))
+    {
+    }
+
+    const std::string &path() const { return mPath; }
+
+    // Lists the universe files, creating the directory if needed
+    bool scan()
+    {
+        mEntries.clear();
+        if (mkdir(mPath.c_str(), 0755) != 0 && errno != EEXIST)
+            return false;
+        DIR *dir = opendir(mPath.c_str());
+        if (!dir)
+            return false;
+
+        std::size_t extension = std::char_traits<char>::length(Extension);
+        while (dirent *file = readdir(dir))
+        {
+            std::string name = file->d_name;
+            if (name.size() > extension && name.compare(name.size() - extension, extension, Extension) == 0)
+            {
+                mEntries.emplace_back();
+                mEntries.back().name = name.substr(0, name.size() - extension);
+            }
+        }
+        closedir(dir);
+
+        std::sort(mEntries.begin(), mEntries.end(), [](const Entry &a, const Entry &b)
+                  { return a.name < b.name; });
+        return true;
+    }
+
+    std::size_t size() const { return mEntries.size(); }
+
+    // The entry at index, with its header read on first use
+    const Entry &entry(std::size_t index)
+    {
+        Entry &entry = mEntries[index];
+        if (!entry.read)
+        {
+            entry.read = true;
+            int fd = open(filePath(entry.name).c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd >= 0)
+            {
+                struct stat info;
+                if (fstat(fd, &info) == 0)
+                    entry.modified = info.st_mtime;
+                entry.valid = entry.header.read(fd) && entry.header.noise.valid() && entry.header.terrain.valid();
+                close(fd);
+            }
+        }
+        return entry;
+    }
+
+    std::string filePath(const std::string &name) const { return mPath + "/" + name + Extension; }
+
+    // A file name for a new universe with the given seed, stepping the seed past names already taken
+    std::string newFilePath(unsigned &seed) const
+    {
+        while (true)
+        {
+            char name[32];
+            std::snprintf(name, sizeof(name), "universe-%08x", seed);
+            std::string path = filePath(name);
+            if (access(path.c_str(), F_OK) != 0)
+                return path;
+            ++seed;
+        }
+    }
+
+private:
+    std::string mPath;
+    std::vector<Entry> mEntries;
+};
+
+// The play screen: pick a saved universe or generate a new one
+class UniverseMenu
+{
+public:
+    enum Result
+    {
+        Result_Play, // path names the universe to play, a file that does not exist yet for a new one
+        Result_Back
+    };
+
+    UniverseMenu(UniverseDirectory &directory, EventLoop &events, int fd)
+        : mDirectory(directory),
+          mEvents(events),
+          mFd(fd),
+          mFrame(8192)
+    {
+    }
+
+    // A line shown under the choices until the next key, e.g. why the last one failed
+    void setMessage(std::string message) { mMessage = std::move(message); }
+
+    // Runs the menu until a universe is chosen or the player backs out.
+    // seed is used for a generated universe and updated to the seed it got.
+    Result run(std::string &path, unsigned &seed)
+    {
+        while (true)
+        {
+            drawPlayScreen();
+            int key;
+            if (!waitKey(key, [this] { drawPlayScreen(); }))
+                return Result_Back;
+            mMessage.clear();
+
+            if (key == '1')
+            {
+                if (select(path))
+                    return Result_Play;
+                if (mQuit)
+                    return Result_Back;
+            }
+            else if (key == '2')
+            {
+                path = mDirectory.newFilePath(seed);
+                return Result_Play;
+            }
+            else if (key == '3' || key == 'q')
+            {
+                return Result_Back;
+            }
+        }
+    }
+
+private:
+    static const int ListRows = 20;
+
+    // keys that are not a single byte, numbered past every byte value
+    enum Key
+    {
+        Key_Up = 256,
+        Key_Down,
+        Key_Escape
+    };
+
+    void drawPlayScreen()
+    {
+        mFrame.clear();
+        mFrame.append("\033[H\033[J");
+        mFrame.append("1 - Select Universe\n");
+        mFrame.append("2 - Generate New Universe\n");
+        mFrame.append("3 - Back to Main Menu\n");
+        if (!mMessage.empty())
+            mFrame.appendf("\n%s\n", mMessage.c_str());
+        mFrame.flush(mFd);
+    }
+
+    void drawList(std::size_t cursor)
+    {
+        static const char *const NoiseNames[] = {"OpenSimplex2", "OpenSimplex2S", "Cellular", "Perlin", "ValueCubic", "Value"};
+
+        mFrame.clear();
+        mFrame.append("\033[H\033[J");
+        mFrame.appendf("Universes in %s  (w/s move, Enter play, b back)\n\n", mDirectory.path().c_str());
+        if (mDirectory.size() == 0)
+            mFrame.append("  no saved universes yet\n");
+
+        std::size_t first = cursor < ListRows / 2 ? 0 : cursor - ListRows / 2;
+        first = std::min(first, mDirectory.size() > ListRows ? mDirectory.size() - ListRows : 0);
+        std::size_t last = std::min(mDirectory.size(), first + ListRows);
+        for (std::size_t i = first; i < last; ++i)
+        {
+            const UniverseDirectory::Entry &entry = mDirectory.entry(i);
+            mFrame.appendf("%c %-24s", i == cursor ? '>' : ' ', entry.name.c_str());
+            if (!entry.valid)
+            {
+                mFrame.append("  unreadable\n");
+                continue;
+            }
+
+            const UniverseHeader &header = entry.header;
+            int type = header.noise.noiseType;
+            char saved[32];
+            std::strftime(saved, sizeof(saved), "%Y-%m-%d %H:%M", std::localtime(&entry.modified));
+            mFrame.appendf("  seed %-10u %-13s at (%.0f, %.0f)  %u patrols  %s\n", (unsigned)header.noise.seed,
+                           type >= 0 && type <= FastNoiseLite::NoiseType_Value ? NoiseNames[type] : "?",
+                           header.cx, header.cy, header.patrolCount, saved);
+        }
+        mFrame.flush(mFd);
+    }
+
+    bool select(std::string &path)
+    {
+        if (!mDirectory.scan())
+            return false;
+
+        std::size_t cursor = 0;
+        while (true)
+        {
+            drawList(cursor);
+            int key;
+            if (!waitKey(key, [&] { drawList(cursor); }))
+                return false;
+
+            if ((key == 'w' || key == Key_Up) && cursor > 0)
+                --cursor;
+            else if ((key == 's' || key == Key_Down) && cursor + 1 < mDirectory.size())
+                ++cursor;
+            else if ((key == '\n' || key == '\r' || key == ' ') && cursor < mDirectory.size() &&
+                     mDirectory.entry(cursor).valid)
+            {
+                path = mDirectory.filePath(mDirectory.entry(cursor).name);
+                return true;
+            }
+            else if (key == 'b' || key == 'q' || key == Key_Escape)
+                return false;
+        }
+    }
+
+    // Blocks until a key arrives, redrawing on resize; false (and mQuit set) when the game is asked to quit.
+    // One read can bring several keys (fast typing, a paste), those not taken yet wait in mPending.
+    template <typename Redraw>
+    bool waitKey(int &key, Redraw redraw)
+    {
+        while (!nextKey(key))
+        {
+            int ready = mEvents.wait();
+            if (ready & EventLoop::Event_Quit)
+            {
+                mQuit = true;
+                return false;
+            }
+            if (ready & EventLoop::Event_Resize)
+                redraw();
+            if (!(ready & EventLoop::Event_Input))
+                continue;
+
+            ssize_t count = read(STDIN_FILENO, mPending, sizeof(mPending));
+            if (count <= 0)
+            {
+                mQuit = true;
+                return false;
+            }
+            mPendingStart = 0;
+            mPendingCount = (int)count;
+        }
+        return true;
+    }
+
+    // Takes the next key from the bytes already read, false once they are used up
+    bool nextKey(int &key)
+    {
+        while (mPendingStart < mPendingCount)
+        {
+            const char *pending = mPending + mPendingStart;
+            int left = mPendingCount - mPendingStart;
+
+            // arrow keys arrive as escape sequences, an escape that does not start one is the key itself
+            if (pending[0] == '\033' && left >= 2 && pending[1] == '[')
+            {
+                // a sequence runs up to its final byte; only plain up and down mean anything here
+                int end = 2;
+                while (end < left && (pending[end] < 0x40 || pending[end] > 0x7e))
+                    ++end;
+                mPendingStart += end < left ? end + 1 : left;
+                if (end == 2 && left > 2 && (pending[2] == 'A' || pending[2] == 'B'))
+                {
+                    key = pending[2] == 'A' ? Key_Up : Key_Down;
+                    return true;
+                }
+                continue;
+            }
+
+            key = pending[0] == '\033' ? (int)Key_Escape : (unsigned char)pending[0];
+            ++mPendingStart;
+            return true;
+        }
+        return false;
+    }
+
+    UniverseDirectory &mDirectory;
+    EventLoop &mEvents;
+    int mFd;
+    FrameBuffer mFrame;
+    bool mQuit = false;
+    std::string mMessage;
+    char mPending[64]; // bytes read from stdin, keys not taken start at mPendingStart
+    int mPendingStart = 0;
+    int mPendingCount = 0;
+};
+
+#endif
@@ -0,0 +1,548 @@
+// Cost of every FastNoiseLite configuration, so noise settings can be chosen by price.
+// Each benchmark evaluates 4096 samples per iteration (a 64x64 or 16x16x16 grid)
+// and reports the time per_sample alongside items_per_second (samples/sec).
+//
+//   NoiseBenchmark --benchmark_filter='Single2D/.*/float'
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "../FastNoise.h"
+
+namespace
+{
+    const int Samples = 4096;
+    const int Side2D = 64;
+    const int Side3D = 16;
+
+    const char *const NoiseNames[] = {"OpenSimplex2", "OpenSimplex2S", "Cellular", "Perlin", "ValueCubic", "Value"};
+    const char *const FractalNames[] = {"None", "FBm", "Ridged", "PingPong", "DomainWarpProgressive", "DomainWarpIndependent"};
+    const char *const DistanceNames[] = {"Euclidean", "EuclideanSq", "Manhattan", "Hybrid"};
+    const char *const ReturnNames[] = {"CellValue", "Distance", "Distance2", "Distance2Add", "Distance2Sub", "Distance2Mul", "Distance2Div"};
+    const char *const WarpNames[] = {"OpenSimplex2", "OpenSimplex2Reduced", "BasicGrid"};
+
+    template <typename T>
+    const char *floatName() { return sizeof(T) == sizeof(float) ? "float" : "double"; }
+
+    void reportSamples(benchmark::State &state)
+    {
+        state.SetItemsProcessed(state.iterations() * Samples);
+        state.counters["per_sample"] = benchmark::Counter(Samples,
+            benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    }
+
+    template <typename T>
+    void noise2D(benchmark::State &state, FastNoiseLite noise)
+    {
+        for (auto _ : state)
+        {
+            float sum = 0.0f;
+            for (int y = 0; y < Side2D; ++y)
+                for (int x = 0; x < Side2D; ++x)
+                    sum += noise.GetNoise((T)x, (T)y);
+            benchmark::DoNotOptimize(sum);
+        }
+        reportSamples(state);
+    }
+
+    template <typename T>
+    void noise3D(benchmark::State &state, FastNoiseLite noise)
+    {
+        for (auto _ : state)
+        {
+            float sum = 0.0f;
+            for (int z = 0; z < Side3D; ++z)
+                for (int y = 0; y < Side3D; ++y)
+                    for (int x = 0; x < Side3D; ++x)
+                        sum += noise.GetNoise((T)x, (T)y, (T)z);
+            benchmark::DoNotOptimize(sum);
+        }
+        reportSamples(state);
+    }
+
+    template <typename T>
+    void warp2D(benchmark::State &state, FastNoiseLite noise)
+    {
+        for (auto _ : state)
+        {
+            T sum = 0;
+            for (int y = 0; y < Side2D; ++y)
+                for (int x = 0; x < Side2D; ++x)
+                {
+                    T wx = (T)x, wy = (T)y;
+                    noise.DomainWarp(wx, wy);
+                    sum += wx + wy;
+                }
+            benchmark::DoNotOptimize(sum);
+        }
+        reportSamples(state);
+    }
+
+    template <typename T>
+    void warp3D(benchmark::State &state, FastNoiseLite noise)
+    {
+        for (auto _ : state)
+        {
+            T sum = 0;
+            for (int z = 0; z < Side3D; ++z)
+                for (int y = 0; y < Side3D; ++y)
+                    for (int x = 0; x < Side3D; ++x)
+                    {
+                        T wx = (T)x, wy = (T)y, wz = (T)z;
+                        noise.DomainWarp(wx, wy, wz);
+                        sum += wx + wy + wz;
+                    }
+            benchmark::DoNotOptimize(sum);
+        }
+        reportSamples(state);
+    }
+
+    // value and gradient per sample, float only; set against Single*/float at three times the cost
+    void derivative2D(benchmark::State &state, FastNoiseLite noise)
+    {
+        for (auto _ : state)
+        {
+            float sum = 0.0f;
+            for (int y = 0; y < Side2D; ++y)
+                for (int x = 0; x < Side2D; ++x)
+                {
+                    float dx, dy;
+                    sum += noise.GetNoiseWithDerivative((float)x, (float)y, dx, dy) + dx + dy;
+                }
+            benchmark::DoNotOptimize(sum);
+        }
+        reportSamples(state);
+    }
+
+    void derivative3D(benchmark::State &state, FastNoiseLite noise)
+    {
+        for (auto _ : state)
+        {
+            float sum = 0.0f;
+            for (int z = 0; z < Side3D; ++z)
+                for (int y = 0; y < Side3D; ++y)
+                    for (int x = 0; x < Side3D; ++x)
+                    {
+                        float dx, dy, dz;
+                        sum += noise.GetNoiseWithDerivative((float)x, (float)y, (float)z, dx, dy, dz) + dx + dy + dz;
+                    }
+            benchmark::DoNotOptimize(sum);
+        }
+        reportSamples(state);
+    }
+
+    // DomainWarp over coordinate arrays, float only; the grid positions are
+    // copied in each iteration as a caller filling its buffers would
+    void warpBatch2D(benchmark::State &state, FastNoiseLite noise)
+    {
+        std::vector<float> xs(Samples), ys(Samples);
+        for (auto _ : state)
+        {
+            for (int i = 0; i < Samples; ++i)
+            {
+                xs[i] = (float)(i % Side2D);
+                ys[i] = (float)(i / Side2D);
+            }
+            noise.DomainWarp(xs.data(), ys.data(), Samples);
+            benchmark::DoNotOptimize(xs.data());
+            benchmark::DoNotOptimize(ys.data());
+        }
+        reportSamples(state);
+    }
+
+    void warpBatch3D(benchmark::State &state, FastNoiseLite noise)
+    {
+        std::vector<float> xs(Samples), ys(Samples), zs(Samples);
+        for (auto _ : state)
+        {
+            for (int i = 0; i < Samples; ++i)
+            {
+                xs[i] = (float)(i % Side3D);
+                ys[i] = (float)(i / Side3D % Side3D);
+                zs[i] = (float)(i / (Side3D * Side3D));
+            }
+            noise.DomainWarp(xs.data(), ys.data(), zs.data(), Samples);
+            benchmark::DoNotOptimize(xs.data());
+            benchmark::DoNotOptimize(ys.data());
+            benchmark::DoNotOptimize(zs.data());
+        }
+        reportSamples(state);
+    }
+
+    // Warped noise the way terrain would use it: one point at a time, or
+    // warped as arrays and fed to the batch GetNoise
+    void warpedNoise2D(benchmark::State &state, FastNoiseLite warp, FastNoiseLite noise)
+    {
+        for (auto _ : state)
+        {
+            float sum = 0.0f;
+            for (int y = 0; y < Side2D; ++y)
+                for (int x = 0; x < Side2D; ++x)
+                {
+                    float wx = (float)x, wy = (float)y;
+                    warp.DomainWarp(wx, wy);
+                    sum += noise.GetNoise(wx, wy);
+                }
+            benchmark::DoNotOptimize(sum);
+        }
+        reportSamples(state);
+    }
+
+    void warpedNoiseBatch2D(benchmark::State &state, FastNoiseLite warp, FastNoiseLite noise)
+    {
+        std::vector<float> xs(Samples), ys(Samples), out(Samples);
+        for (auto _ : state)
+        {
+            for (int i = 0; i < Samples; ++i)
+            {
+                xs[i] = (float)(i % Side2D);
+                ys[i] = (float)(i / Side2D);
+            }
+            warp.DomainWarp(xs.data(), ys.data(), Samples);
+            noise.GetNoise(xs.data(), ys.data(), out.data(), Samples);
+            benchmark::DoNotOptimize(out.data());
+        }
+        reportSamples(state);
+    }
+
+    // the block evaluator behind GenGrid2D/3D, float only
+    void grid2D(benchmark::State &state, FastNoiseLite noise)
+    {
+        std::vector<float> out(Samples);
+        for (auto _ : state)
+        {
+            noise.GenGrid2D(out.data(), 0, 0, Side2D, Side2D);
+            benchmark::DoNotOptimize(out.data());
+        }
+        reportSamples(state);
+    }
+
+    void grid3D(benchmark::State &state, FastNoiseLite noise)
+    {
+        std::vector<float> out(Samples);
+        for (auto _ : state)
+        {
+            noise.GenGrid3D(out.data(), 0, 0, 0, Side3D, Side3D, Side3D);
+            benchmark::DoNotOptimize(out.data());
+        }
+        reportSamples(state);
+    }
+
+    // Fields generated per grid position by the multi-field benchmarks, like a
+    // map's elevation, moisture and temperature layers
+    const int Fields = 3;
+    const int FieldSeeds[Fields] = {1337, 1338, 1339};
+
+    // all fields in one GenGridMulti2D/3D pass, per_sample covers every field of a position
+    void gridMulti2D(benchmark::State &state, FastNoiseLite noise)
+    {
+        std::vector<float> out(Fields * Samples);
+        float *fields[Fields];
+        for (int f = 0; f < Fields; ++f)
+            fields[f] = out.data() + f * Samples;
+        for (auto _ : state)
+        {
+            noise.GenGridMulti2D(fields, FieldSeeds, Fields, 0, 0, Side2D, Side2D);
+            benchmark::DoNotOptimize(out.data());
+        }
+        reportSamples(state);
+    }
+
+    void gridMulti3D(benchmark::State &state, FastNoiseLite noise)
+    {
+        std::vector<float> out(Fields * Samples);
+        float *fields[Fields];
+        for (int f = 0; f < Fields; ++f)
+            fields[f] = out.data() + f * Samples;
+        for (auto _ : state)
+        {
+            noise.GenGridMulti3D(fields, FieldSeeds, Fields, 0, 0, 0, Side3D, Side3D, Side3D);
+            benchmark::DoNotOptimize(out.data());
+        }
+        reportSamples(state);
+    }
+
+    // the same fields from one GenGrid2D/3D call per seed
+    void gridSeeds2D(benchmark::State &state, FastNoiseLite noise)
+    {
+        std::vector<float> out(Fields * Samples);
+        for (auto _ : state)
+        {
+            for (int f = 0; f < Fields; ++f)
+            {
+                noise.SetSeed(FieldSeeds[f]);
+                noise.GenGrid2D(out.data() + f * Samples, 0, 0, Side2D, Side2D);
+            }
+            benchmark::DoNotOptimize(out.data());
+        }
+        reportSamples(state);
+    }
+
+    void gridSeeds3D(benchmark::State &state, FastNoiseLite noise)
+    {
+        std::vector<float> out(Fields * Samples);
+        for (auto _ : state)
+        {
+            for (int f = 0; f < Fields; ++f)
+            {
+                noise.SetSeed(FieldSeeds[f]);
+                noise.GenGrid3D(out.data() + f * Samples, 0, 0, 0, Side3D, Side3D, Side3D);
+            }
+            benchmark::DoNotOptimize(out.data());
+        }
+        reportSamples(state);
+    }
+
+    // GetNoise through the compile-time specialized front-end, float only
+    template <FastNoiseLite::NoiseType Noise, FastNoiseLite::FractalType Fractal>
+    void specialized2D(benchmark::State &state, FastNoiseLite settings)
+    {
+        FastNoise<Noise, Fractal> noise(settings);
+        for (auto _ : state)
+        {
+            float sum = 0.0f;
+            for (int y = 0; y < Side2D; ++y)
+                for (int x = 0; x < Side2D; ++x)
+                    sum += noise.GetNoise((float)x, (float)y);
+            benchmark::DoNotOptimize(sum);
+        }
+        reportSamples(state);
+    }
+
+    template <FastNoiseLite::NoiseType Noise, FastNoiseLite::FractalType Fractal>
+    void specialized3D(benchmark::State &state, FastNoiseLite settings)
+    {
+        FastNoise<Noise, Fractal> noise(settings);
+        for (auto _ : state)
+        {
+            float sum = 0.0f;
+            for (int z = 0; z < Side3D; ++z)
+                for (int y = 0; y < Side3D; ++y)
+                    for (int x = 0; x < Side3D; ++x)
+                        sum += noise.GetNoise((float)x, (float)y, (float)z);
+            benchmark::DoNotOptimize(sum);
+        }
+        reportSamples(state);
+    }
+
+    template <typename Fn>
+    void add(const std::string &name, Fn fn, const FastNoiseLite &noise)
+    {
+        benchmark::RegisterBenchmark(name.c_str(), fn, noise);
+    }
+
+    // Every GenNoiseSingle path, cellular in each distance/return combination
+    template <typename T>
+    void registerSingle()
+    {
+        for (int type = 0; type <= FastNoiseLite::NoiseType_Value; ++type)
+        {
+            FastNoiseLite noise;
+            noise.SetNoiseType((FastNoiseLite::NoiseType)type);
+
+            if (type != FastNoiseLite::NoiseType_Cellular)
+            {
+                std::string name = std::string("/") + NoiseNames[type] + "/" + floatName<T>();
+                add("Single2D" + name, noise2D<T>, noise);
+                add("Single3D" + name, noise3D<T>, noise);
+                continue;
+            }
+
+            for (int distance = 0; distance <= FastNoiseLite::CellularDistanceFunction_Hybrid; ++distance)
+                for (int ret = 0; ret <= FastNoiseLite::CellularReturnType_Distance2Div; ++ret)
+                {
+                    noise.SetCellularDistanceFunction((FastNoiseLite::CellularDistanceFunction)distance);
+                    noise.SetCellularReturnType((FastNoiseLite::CellularReturnType)ret);
+                    std::string name = std::string("/Cellular/") + DistanceNames[distance] + "/" +
+                                       ReturnNames[ret] + "/" + floatName<T>();
+                    add("Single2D" + name, noise2D<T>, noise);
+                    add("Single3D" + name, noise3D<T>, noise);
+                }
+        }
+    }
+
+    // Each GenFractal* mode over 1-8 octaves of the default OpenSimplex2;
+    // other base types scale with their Single cost
+    template <typename T>
+    void registerFractal()
+    {
+        for (int fractal = FastNoiseLite::FractalType_FBm; fractal <= FastNoiseLite::FractalType_PingPong; ++fractal)
+            for (int octaves = 1; octaves <= 8; ++octaves)
+            {
+                FastNoiseLite noise;
+                noise.SetFractalType((FastNoiseLite::FractalType)fractal);
+                noise.SetFractalOctaves(octaves);
+                std::string name = std::string("/") + FractalNames[fractal] + "/octaves:" +
+                                   std::to_string(octaves) + "/" + floatName<T>();
+                add("Fractal2D" + name, noise2D<T>, noise);
+                add("Fractal3D" + name, noise3D<T>, noise);
+            }
+    }
+
+    // Every DomainWarpType, single and with each warp fractal at the default 3 octaves
+    template <typename T>
+    void registerWarp()
+    {
+        const int fractals[] = {FastNoiseLite::FractalType_None,
+                                FastNoiseLite::FractalType_DomainWarpProgressive,
+                                FastNoiseLite::FractalType_DomainWarpIndependent};
+        for (int warp = 0; warp <= FastNoiseLite::DomainWarpType_BasicGrid; ++warp)
+            for (int fractal : fractals)
+            {
+                FastNoiseLite noise;
+                noise.SetDomainWarpType((FastNoiseLite::DomainWarpType)warp);
+                noise.SetDomainWarpAmp(30.0f);
+                noise.SetFractalType((FastNoiseLite::FractalType)fractal);
+                std::string name = std::string("/") + WarpNames[warp] + "/" + FractalNames[fractal] + "/" +
+                                   floatName<T>();
+                add("DomainWarp2D" + name, warp2D<T>, noise);
+                add("DomainWarp3D" + name, warp3D<T>, noise);
+            }
+    }
+
+    // GetNoiseWithDerivative where it is analytic, and one finite difference fallback
+    void registerDerivative()
+    {
+        const int types[] = {FastNoiseLite::NoiseType_OpenSimplex2, FastNoiseLite::NoiseType_Perlin,
+                             FastNoiseLite::NoiseType_ValueCubic};
+        for (int type : types)
+            for (int fractal = FastNoiseLite::FractalType_None; fractal <= FastNoiseLite::FractalType_FBm; ++fractal)
+            {
+                FastNoiseLite noise;
+                noise.SetNoiseType((FastNoiseLite::NoiseType)type);
+                noise.SetFractalType((FastNoiseLite::FractalType)fractal);
+                std::string name = std::string("/") + NoiseNames[type] + "/" + FractalNames[fractal];
+                add("Derivative2D" + name, derivative2D, noise);
+                add("Derivative3D" + name, derivative3D, noise);
+            }
+    }
+
+    // The array DomainWarp for every DomainWarpType and warp fractal, to set against
+    // DomainWarp*/float; and warped Perlin FBm both ways
+    void registerWarpBatch()
+    {
+        const int fractals[] = {FastNoiseLite::FractalType_None,
+                                FastNoiseLite::FractalType_DomainWarpProgressive,
+                                FastNoiseLite::FractalType_DomainWarpIndependent};
+        for (int warp = 0; warp <= FastNoiseLite::DomainWarpType_BasicGrid; ++warp)
+        {
+            for (int fractal : fractals)
+            {
+                FastNoiseLite noise;
+                noise.SetDomainWarpType((FastNoiseLite::DomainWarpType)warp);
+                noise.SetDomainWarpAmp(30.0f);
+                noise.SetFractalType((FastNoiseLite::FractalType)fractal);
+                std::string name = std::string("/") + WarpNames[warp] + "/" + FractalNames[fractal];
+                add("DomainWarpBatch2D" + name, warpBatch2D, noise);
+                add("DomainWarpBatch3D" + name, warpBatch3D, noise);
+            }
+
+            FastNoiseLite warper;
+            warper.SetDomainWarpType((FastNoiseLite::DomainWarpType)warp);
+            warper.SetDomainWarpAmp(30.0f);
+            FastNoiseLite noise;
+            noise.SetNoiseType(FastNoiseLite::NoiseType_Perlin);
+            noise.SetFractalType(FastNoiseLite::FractalType_FBm);
+            std::string name = std::string("WarpedNoise2D/") + WarpNames[warp] + "/Perlin/FBm";
+            benchmark::RegisterBenchmark((name + "/single").c_str(), warpedNoise2D, warper, noise);
+            benchmark::RegisterBenchmark((name + "/batch").c_str(), warpedNoiseBatch2D, warper, noise);
+        }
+    }
+
+    template <FastNoiseLite::NoiseType Noise, FastNoiseLite::FractalType Fractal>
+    void addSpecialized()
+    {
+        FastNoiseLite noise;
+        noise.SetNoiseType(Noise);
+        noise.SetFractalType(Fractal);
+        std::string name = std::string("/") + NoiseNames[Noise] + "/" + FractalNames[Fractal];
+        add("Specialized2D" + name, specialized2D<Noise, Fractal>, noise);
+        add("Specialized3D" + name, specialized3D<Noise, Fractal>, noise);
+    }
+
+    template <FastNoiseLite::NoiseType Noise>
+    void addSpecialized()
+    {
+        addSpecialized<Noise, FastNoiseLite::FractalType_None>();
+        addSpecialized<Noise, FastNoiseLite::FractalType_FBm>();
+        addSpecialized<Noise, FastNoiseLite::FractalType_Ridged>();
+        addSpecialized<Noise, FastNoiseLite::FractalType_PingPong>();
+    }
+
+    // The FastNoise front-end for every noise and fractal type, to set against
+    // Single*/float and Fractal*/octaves:3/float
+    void registerSpecialized()
+    {
+        addSpecialized<FastNoiseLite::NoiseType_OpenSimplex2>();
+        addSpecialized<FastNoiseLite::NoiseType_OpenSimplex2S>();
+        addSpecialized<FastNoiseLite::NoiseType_Cellular>();
+        addSpecialized<FastNoiseLite::NoiseType_Perlin>();
+        addSpecialized<FastNoiseLite::NoiseType_ValueCubic>();
+        addSpecialized<FastNoiseLite::NoiseType_Value>();
+    }
+
+    void registerGrid()
+    {
+        for (int type = 0; type <= FastNoiseLite::NoiseType_Value; ++type)
+            for (int fractal = FastNoiseLite::FractalType_None; fractal <= FastNoiseLite::FractalType_PingPong; ++fractal)
+            {
+                FastNoiseLite noise;
+                noise.SetNoiseType((FastNoiseLite::NoiseType)type);
+                noise.SetFractalType((FastNoiseLite::FractalType)fractal);
+                std::string name = std::string("/") + NoiseNames[type] + "/" + FractalNames[fractal];
+                add("Grid2D" + name, grid2D, noise);
+                add("Grid3D" + name, grid3D, noise);
+            }
+
+        // low jitter cellular, where the 2D tile evaluator only searches 2x2 cells for the closest point
+        for (int ret = FastNoiseLite::CellularReturnType_CellValue; ret <= FastNoiseLite::CellularReturnType_Distance; ++ret)
+        {
+            FastNoiseLite noise;
+            noise.SetNoiseType(FastNoiseLite::NoiseType_Cellular);
+            noise.SetCellularReturnType((FastNoiseLite::CellularReturnType)ret);
+            noise.SetCellularJitter(0.3f);
+            std::string name = std::string("/Cellular/") + ReturnNames[ret] + "/jitter:0.3";
+            add("Grid2D" + name, grid2D, noise);
+            add("Single2D" + name + "/float", noise2D<float>, noise);
+        }
+    }
+
+    // Three seeds of one configuration, in one multi-field pass and one grid per seed
+    void registerGridMulti()
+    {
+        for (int type = 0; type <= FastNoiseLite::NoiseType_Value; ++type)
+            for (int fractal = FastNoiseLite::FractalType_None; fractal <= FastNoiseLite::FractalType_FBm; ++fractal)
+            {
+                FastNoiseLite noise;
+                noise.SetNoiseType((FastNoiseLite::NoiseType)type);
+                noise.SetFractalType((FastNoiseLite::FractalType)fractal);
+                std::string name = std::string("/") + NoiseNames[type] + "/" + FractalNames[fractal] + "/fields:3";
+                add("GridMulti2D" + name + "/multi", gridMulti2D, noise);
+                add("GridMulti2D" + name + "/separate", gridSeeds2D, noise);
+                add("GridMulti3D" + name + "/multi", gridMulti3D, noise);
+                add("GridMulti3D" + name + "/separate", gridSeeds3D, noise);
+            }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    registerSingle<float>();
+    registerSingle<double>();
+    registerFractal<float>();
+    registerFractal<double>();
+    registerWarp<float>();
+    registerWarp<double>();
+    registerWarpBatch();
+    registerDerivative();
+    registerSpecialized();
+    registerGrid();
+    registerGridMulti();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -1,13 +1,32 @@
-#include <iostream>
 #include <random>
 #include <vector>
 #include <algorithm>
 #include <termios.h>
 #include <unistd.h>
 #include <chrono>
+#include <cerrno>
 #include <cmath>
-#include <fcntl.h>
-#include "FastNoiseLite.h"
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include "FastNoise.h"
+#include "TerrainCache.h"
+#include "ChunkStore.h"
+#include "ChunkPrefetcher.h"
+#include "TerminalRenderer.h"
+#include "Simulation.h"
+#include "EventLoop.h"
+#include "Universe.h"
+#include "UniverseMenu.h"
+
+const int ViewW = 80;
+const int ViewH = 25;
+const std::size_t TerrainCacheBytes = 4 << 20;
+const float MaxFrameTime = 0.25f; // longest stall the simulation catches up on
 
 void setRawMode(bool enable)
 {
@@ -18,235 +37,544 @@ void setRawMode(bool enable)
         tcgetattr(STDIN_FILENO, &oldt);
         newt = oldt;
         newt.c_lflag &= ~(ICANON | ECHO);
+        // a read returns whatever is buffered once the event loop reports input
+        newt.c_cc[VMIN] = 1;
+        newt.c_cc[VTIME] = 0;
         tcsetattr(STDIN_FILENO, TCSANOW, &newt);
-        int flags = fcntl(STDIN_FILENO, F_GETFL, 0);
-        fcntl(STDIN_FILENO, F_SETFL, flags | O_NONBLOCK);
     }
     else
     {
         tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-        int flags = fcntl(STDIN_FILENO, F_GETFL, 0);
-        fcntl(STDIN_FILENO, F_SETFL, flags & ~O_NONBLOCK);
     }
 }
 
-char getSymbol(float v)
+struct Options
+{
+    float tickRate = 60.0f;   // simulation steps per second
+    float renderRate = 60.0f; // maximum frames drawn per second
+    bool hasSeed = false;
+    unsigned seed = 0;
+    int threads = -1; // prefetch threads, -1 picks from the hardware
+    std::string universe; // file to resume from and save to on quit, created if missing; skips the menu
+    std::string universes = "universes"; // directory the universe menu lists and creates files in
+
+    // headless benchmark: replay a script against a virtual clock and report frame times
+    bool headless = false;
+    int frames = 1000;
+    std::string script;
+};
+
+Options parseOptions(int argc, char **argv)
 {
-    if (v < -0.3f)
-        return '.';
-    if (v < 0.0f)
-        return ':';
-    if (v < 0.3f)
-        return '*';
-    if (v < 0.6f)
-        return '#';
-    return '@';
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--tick-rate") && i + 1 < argc)
+            options.tickRate = std::max(1.0f, (float)std::atof(argv[++i]));
+        else if (!std::strcmp(argv[i], "--render-rate") && i + 1 < argc)
+            options.renderRate = std::max(1.0f, (float)std::atof(argv[++i]));
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc)
+        {
+            options.hasSeed = true;
+            options.seed = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (!std::strcmp(argv[i], "--universe") && i + 1 < argc)
+            options.universe = argv[++i];
+        else if (!std::strcmp(argv[i], "--universes") && i + 1 < argc)
+            options.universes = argv[++i];
+        else if (!std::strcmp(argv[i], "--threads") && i + 1 < argc)
+            options.threads = std::max(0, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--headless"))
+            options.headless = true;
+        else if (!std::strcmp(argv[i], "--frames") && i + 1 < argc)
+            options.frames = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--script") && i + 1 < argc)
+            options.script = argv[++i];
+    }
+    return options;
 }
 
-struct Patrol
+// Terminals only report key presses (and auto-repeats), never releases, so a
+// movement key counts as held while its last press is recent
+struct KeyState
 {
-    float wx, wy;
-    float stamina;
-    bool active;
+    static constexpr float Timeout = 0.16f; // seconds
+
+    float up = -1.0f, down = -1.0f, left = -1.0f, right = -1.0f, run = -1.0f;
+
+    void press(char ch, float now)
+    {
+        // movement keys (lowercase)
+        if (ch == 'w')
+            up = now;
+        if (ch == 's')
+            down = now;
+        if (ch == 'a')
+            left = now;
+        if (ch == 'd')
+            right = now;
+        // uppercase indicates Shift held for that event
+        if (ch == 'W')
+        {
+            up = now;
+            run = now;
+        }
+        if (ch == 'S')
+        {
+            down = now;
+            run = now;
+        }
+        if (ch == 'A')
+        {
+            left = now;
+            run = now;
+        }
+        if (ch == 'D')
+        {
+            right = now;
+            run = now;
+        }
+        // ignore other chars
+    }
+
+    MoveInput held(float now) const
+    {
+        auto recent = [&](float t) { return t >= 0.0f && now - t < Timeout; };
+        return {recent(up), recent(down), recent(left), recent(right), recent(run)};
+    }
+};
+
+// Camera for a frame drawn a fraction alpha of the way from the previous tick to the latest
+struct View
+{
+    float alpha;
+    float cx, cy;
+    int camX, camY;
 };
 
-int main()
+View viewAt(const Simulation &sim, float alpha, int viewW, int viewH)
+{
+    View view;
+    view.alpha = alpha;
+    view.cx = sim.prevCx + (sim.cx - sim.prevCx) * alpha;
+    view.cy = sim.prevCy + (sim.cy - sim.prevCy) * alpha;
+    view.camX = (int)std::floor(view.cx - viewW / 2.0f);
+    view.camY = (int)std::floor(view.cy - viewH / 2.0f);
+    return view;
+}
+
+// Overlays are stamped straight into the viewport grid, one floor per entity,
+// patrols last so they cover the player like before
+void stampEntities(char *cells, int viewW, int viewH, const Simulation &sim, const View &view)
+{
+    int playerX = (int)std::floor(view.cx) - view.camX;
+    int playerY = (int)std::floor(view.cy) - view.camY;
+    if (playerX >= 0 && playerX < viewW && playerY >= 0 && playerY < viewH)
+        cells[playerY * viewW + playerX] = 'X';
+
+    const Patrols &patrols = sim.patrols;
+    for (std::size_t i = 0; i < patrols.size(); ++i)
+    {
+        float wx = patrols.prevWx[i] + (patrols.wx[i] - patrols.prevWx[i]) * view.alpha;
+        float wy = patrols.prevWy[i] + (patrols.wy[i] - patrols.prevWy[i]) * view.alpha;
+        int px = (int)std::floor(wx) - view.camX;
+        int py = (int)std::floor(wy) - view.camY;
+        if (px >= 0 && px < viewW && py >= 0 && py < viewH)
+            cells[py * viewW + px] = 'P';
+    }
+}
+
+void setStatus(TerminalRenderer &renderer, const Simulation &sim, const MoveInput &input)
+{
+    renderer.setStatus("Pos: (%g, %g)  Active patrols: %d  Run: %s",
+                       sim.cx, sim.cy, (int)sim.patrols.size(), input.run ? "YES" : "no");
+}
+
+// Key presses for a headless run. Each line is "<frame> <keys>" or
+// "<first>-<last> <keys>", the keys being delivered at the start of every
+// listed frame; '#' starts a comment.
+struct InputScript
 {
-    const int viewW = 80;
-    const int viewH = 25;
-    const float walkSpeed = 1.5f;
-    const float runSpeed = 5.0f;
-    const float patrolSpeed = 4.2f;
-    const float patrolStamina = 20.0f;
-
-    FastNoiseLite noise;
-    noise.SetSeed(std::random_device{}());
-    noise.SetNoiseType(FastNoiseLite::NoiseType_Perlin);
-    noise.SetFrequency(0.05f);
-
-    float cx = 0.0f, cy = 0.0f;
-
-    std::vector<Patrol> patrols;
-    std::mt19937 rng(std::random_device{}());
-    std::uniform_real_distribution<float> spawnDist(-15.0f, 15.0f);
-    std::uniform_real_distribution<float> timeDist(5.0f, 12.0f);
-    float nextSpawnTime = timeDist(rng);
-    float spawnTimer = 0.0f;
-
-    // key hold timestamps
+    struct Entry
+    {
+        int first, last;
+        std::string keys;
+    };
+    std::vector<Entry> entries;
+
+    bool load(const std::string &path)
+    {
+        std::ifstream file(path);
+        if (!file)
+            return false;
+        std::string line;
+        while (std::getline(file, line))
+        {
+            line = line.substr(0, line.find('#'));
+            std::istringstream fields(line);
+            std::string frames;
+            Entry entry;
+            if (!(fields >> frames >> entry.keys))
+                continue;
+            std::size_t dash = frames.find('-');
+            entry.first = std::atoi(frames.c_str());
+            entry.last = dash == std::string::npos ? entry.first : std::atoi(frames.c_str() + dash + 1);
+            entries.push_back(entry);
+        }
+        return true;
+    }
+
+    void keysAt(int frame, std::string &out) const
+    {
+        out.clear();
+        for (const Entry &entry : entries)
+            if (frame >= entry.first && frame <= entry.last)
+                out += entry.keys;
+    }
+};
+
+// Per-frame durations of one phase, in milliseconds
+struct PhaseTimes
+{
+    const char *name;
+    std::vector<double> samples;
+
+    double percentile(double p) const
+    {
+        std::vector<double> sorted = samples;
+        std::sort(sorted.begin(), sorted.end());
+        std::size_t rank = (std::size_t)std::ceil(p * sorted.size());
+        return sorted[std::max<std::size_t>(rank, 1) - 1];
+    }
+};
+
+// Loads the universe at path, or starts a new one from seed when there is no file (or no path)
+bool loadUniverse(const std::string &path, unsigned seed, Universe &universe)
+{
+    universe = Universe((int32_t)seed);
+    if (!path.empty() && access(path.c_str(), F_OK) == 0 && !universe.load(path))
+    {
+        std::fprintf(stderr, "%s is not a readable universe\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Explored terrain is kept next to the universe file; without one chunks are only regenerated
+ChunkStore *openChunkStore(const std::string &universePath, const Universe &universe, ChunkStore &store)
+{
+    if (universePath.empty())
+        return nullptr;
+    std::string storePath = universePath + ".chunks";
+    if (!store.open(storePath, universe.terrainFingerprint()))
+    {
+        std::perror(storePath.c_str());
+        return nullptr;
+    }
+    return &store;
+}
+
+// Replays a scripted session without a terminal: the clock advances exactly
+// one render interval per frame, frames are composed into a renderer that
+// discards them, and the time spent in each phase is reported at the end
+int runHeadless(const Options &options)
+{
+    InputScript script;
+    if (!options.script.empty() && !script.load(options.script))
+    {
+        std::fprintf(stderr, "cannot read script %s\n", options.script.c_str());
+        return 1;
+    }
+
     using clock = std::chrono::steady_clock;
-    clock::time_point t_up{}, t_down{}, t_left{}, t_right{}, t_run{};
-    const float keyTimeout = 0.16f; // seconds: consider key held while recent
+    auto ms = [](clock::time_point a, clock::time_point b)
+    { return std::chrono::duration<double, std::milli>(b - a).count(); };
+
+    const float tickDt = 1.0f / options.tickRate;
+    const float renderInterval = 1.0f / options.renderRate;
+
+    // reproducible by default: a fixed seed and no prefetching unless asked for
+    Universe universe;
+    if (!loadUniverse(options.universe, options.hasSeed ? options.seed : 1337u, universe))
+        return 1;
+
+    FastNoiseLite settings;
+    universe.noise().apply(settings);
+    std::unique_ptr<NoiseGenerator> noise = MakeFastNoise(settings);
+
+    Simulation sim(universe.simulationSeed());
+    universe.restore(sim);
+
+    ChunkStore chunkStore;
+    TerrainCache terrainCache(*noise, SymbolTable(universe.terrain()), TerrainCacheBytes,
+                              openChunkStore(options.universe, universe, chunkStore));
+    ChunkPrefetcher prefetcher(terrainCache, std::max(options.threads, 0));
+
+    TerminalRenderer renderer(ViewW, ViewH, -1);
+    KeyState keys;
+    std::string pressed;
+    float virtualTime = 0.0f;
+    float accumulator = 0.0f;
+    std::size_t bytes = 0;
+
+    PhaseTimes inputTimes{"input", {}}, simTimes{"sim", {}}, noiseTimes{"noise", {}};
+    PhaseTimes renderTimes{"render", {}}, frameTimes{"frame", {}};
+    for (PhaseTimes *phase : {&inputTimes, &simTimes, &noiseTimes, &renderTimes, &frameTimes})
+        phase->samples.reserve(options.frames);
+
+    int frame = 0;
+    bool quit = false;
+    for (; frame < options.frames && !quit; ++frame)
+    {
+        auto t0 = clock::now();
+        script.keysAt(frame, pressed);
+        for (char ch : pressed)
+        {
+            if (ch == 'q')
+                quit = true;
+            keys.press(ch, virtualTime);
+        }
+        MoveInput moveInput = keys.held(virtualTime);
+
+        auto t1 = clock::now();
+        while (accumulator >= tickDt)
+        {
+            sim.tick(tickDt, moveInput);
+            accumulator -= tickDt;
+        }
+        float dx, dy;
+        Simulation::direction(moveInput, dx, dy);
+        prefetcher.update(sim.cx, sim.cy, dx, dy, Simulation::speedFor(moveInput), ViewW, ViewH);
+
+        auto t2 = clock::now();
+        View view = viewAt(sim, accumulator / tickDt, ViewW, ViewH);
+        terrainCache.fillView(renderer.cells(), view.camX, view.camY, ViewW, ViewH);
+
+        auto t3 = clock::now();
+        stampEntities(renderer.cells(), ViewW, ViewH, sim, view);
+        setStatus(renderer, sim, moveInput);
+        renderer.present();
+        bytes += renderer.lastBytes();
+
+        auto t4 = clock::now();
+        inputTimes.samples.push_back(ms(t0, t1));
+        simTimes.samples.push_back(ms(t1, t2));
+        noiseTimes.samples.push_back(ms(t2, t3));
+        renderTimes.samples.push_back(ms(t3, t4));
+        frameTimes.samples.push_back(ms(t0, t4));
+
+        virtualTime += renderInterval;
+        accumulator += renderInterval;
+    }
+
+    std::printf("%d frames, %.1f s simulated, %zu bytes rendered, %zu chunks missed, %zu loaded\n",
+                frame, virtualTime, bytes, terrainCache.missedChunks(), terrainCache.loadedChunks());
+    std::printf("%-8s %10s %10s %10s %10s\n", "phase", "p50 ms", "p95 ms", "p99 ms", "max ms");
+    for (const PhaseTimes *phase : {&inputTimes, &simTimes, &noiseTimes, &renderTimes, &frameTimes})
+        std::printf("%-8s %10.4f %10.4f %10.4f %10.4f\n", phase->name, phase->percentile(0.50),
+                    phase->percentile(0.95), phase->percentile(0.99), phase->percentile(1.0));
+    return 0;
+}
+
+// Shows the universe menu unless a universe was named on the command line,
+// then plays the chosen universe until quit and saves it
+int runInteractive(const Options &options)
+{
+    const float tickDt = 1.0f / options.tickRate;
+    const float renderInterval = 1.0f / options.renderRate;
+
+    // blocks the terminal signals, so it has to exist before the prefetch threads
+    EventLoop events(STDIN_FILENO);
+    if (!events.ok())
+    {
+        std::perror("event loop");
+        return 1;
+    }
 
     setRawMode(true);
-    auto lastTime = clock::now();
 
-    while (true)
+    unsigned seed = options.hasSeed ? options.seed : std::random_device{}();
+    std::string universePath = options.universe;
+    bool fromMenu = universePath.empty();
+    UniverseDirectory directory(options.universes);
+    UniverseMenu menu(directory, events, STDOUT_FILENO);
+    if (fromMenu && !directory.scan())
     {
-        auto now = clock::now();
-        std::chrono::duration<float> deltaTime = now - lastTime;
-        lastTime = now;
-        float dt = deltaTime.count();
+        setRawMode(false);
+        std::perror(options.universes.c_str());
+        return 1;
+    }
 
-        // Read all available key presses and update timestamps
-        char ch;
-        while (read(STDIN_FILENO, &ch, 1) > 0)
+    Universe universe;
+    while (true)
+    {
+        if (fromMenu && menu.run(universePath, seed) == UniverseMenu::Result_Back)
         {
-            if (ch == 'q')
-            {
-                setRawMode(false);
-                std::cout << "\033[H\033[J";
-                return 0;
-            }
-            // movement keys (lowercase)
-            if (ch == 'w')
-                t_up = now;
-            if (ch == 's')
-                t_down = now;
-            if (ch == 'a')
-                t_left = now;
-            if (ch == 'd')
-                t_right = now;
-            // uppercase indicates Shift held for that event
-            if (ch == 'W')
-            {
-                t_up = now;
-                t_run = now;
-            }
-            if (ch == 'S')
-            {
-                t_down = now;
-                t_run = now;
-            }
-            if (ch == 'A')
-            {
-                t_left = now;
-                t_run = now;
-            }
-            if (ch == 'D')
-            {
-                t_right = now;
-                t_run = now;
-            }
-            // ignore other chars
+            setRawMode(false);
+            std::fputs("\033[H\033[J", stdout);
+            return 0;
         }
+        bool created = access(universePath.c_str(), F_OK) != 0;
+        if (!loadUniverse(universePath, seed, universe))
+        {
+            setRawMode(false);
+            return 1;
+        }
+        if (!created)
+            break;
 
-        // Determine which keys are currently considered held
-        auto held = [&](const clock::time_point &t) -> bool
+        // a new universe is written out before play, so one that cannot be kept is caught now
+        Simulation start(universe.simulationSeed());
+        universe.capture(start);
+        if (universe.save(universePath))
+            break;
+        int error = errno;
+        if (!fromMenu)
         {
-            if (t == clock::time_point{})
-                return false;
-            std::chrono::duration<float> age = now - t;
-            return age.count() < keyTimeout;
-        };
+            setRawMode(false);
+            std::fprintf(stderr, "%s: %s\n", universePath.c_str(), std::strerror(error));
+            return 1;
+        }
+        menu.setMessage("Could not save " + universePath + ": " + std::strerror(error));
+        universePath.clear();
+    }
+
+    FastNoiseLite settings;
+    universe.noise().apply(settings);
+    std::unique_ptr<NoiseGenerator> noise = MakeFastNoise(settings);
+
+    Simulation sim(universe.simulationSeed());
+    universe.restore(sim);
 
-        bool up = held(t_up);
-        bool down = held(t_down);
-        bool left = held(t_left);
-        bool right = held(t_right);
-        bool run = held(t_run);
+    int threads = options.threads >= 0 ? options.threads : (int)std::clamp(std::thread::hardware_concurrency(), 2u, 5u) - 1;
+    ChunkStore chunkStore;
+    TerrainCache terrainCache(*noise, SymbolTable(universe.terrain()), TerrainCacheBytes,
+                              openChunkStore(universePath, universe, chunkStore));
+    ChunkPrefetcher prefetcher(terrainCache, threads);
 
-        // Movement vector
-        float dx = 0.0f, dy = 0.0f;
-        float speed = run ? runSpeed : walkSpeed;
+    // terrain around the spawn point starts streaming before the first frame asks for it
+    prefetcher.update(sim.cx, sim.cy, 0.0f, 0.0f, 0.0f, ViewW, ViewH);
 
-        if (up)
-            dy -= speed * dt;
-        if (down)
-            dy += speed * dt;
-        if (left)
-            dx -= speed * dt;
-        if (right)
-            dx += speed * dt;
+    TerminalRenderer renderer(ViewW, ViewH, STDOUT_FILENO);
+
+    using clock = std::chrono::steady_clock;
+    const auto startTime = clock::now();
+    KeyState keys;
 
-        cx += dx;
-        cy += dy;
+    auto lastTime = startTime;
+    float accumulator = 0.0f;
+    float renderTimer = renderInterval; // draw the first frame immediately
+    bool dirty = true;                  // something visible may have changed since the last frame
+    bool wasIdle = false;
+    bool timerPeriodic = false;
+    bool quit = false;
+    int ready = 0; // events reported by the last wait
 
-        // spawn patrols
-        spawnTimer += dt;
-        if (spawnTimer >= nextSpawnTime)
+    while (!quit)
+    {
+        auto now = clock::now();
+        std::chrono::duration<float> deltaTime = now - lastTime;
+        lastTime = now;
+        float seconds = std::chrono::duration<float>(now - startTime).count();
+        // an idle simulation only counts down to the next spawn, so the whole
+        // gap is caught up on; otherwise a stall is clamped as before
+        float frameTime = wasIdle ? deltaTime.count() : std::min(deltaTime.count(), MaxFrameTime);
+        accumulator += frameTime;
+        renderTimer += frameTime;
+
+        if (ready & EventLoop::Event_Quit)
+            break;
+        if (ready & EventLoop::Event_Resize)
         {
-            spawnTimer = 0;
-            nextSpawnTime = timeDist(rng);
-            Patrol p{cx + spawnDist(rng), cy + spawnDist(rng), patrolStamina, true};
-            patrols.push_back(p);
+            renderer.invalidate();
+            dirty = true;
         }
 
-        // update patrols
-        for (auto &p : patrols)
+        // Read the key presses that woke us and update timestamps
+        if (ready & EventLoop::Event_Input)
         {
-            if (!p.active)
-                continue;
-            if (p.stamina <= 0.0f)
-            {
-                p.active = false;
-                continue;
-            }
-            float vx = cx - p.wx;
-            float vy = cy - p.wy;
-            float len = std::sqrt(vx * vx + vy * vy);
-            if (len > 0.001f)
+            char pressed[64];
+            ssize_t count = read(STDIN_FILENO, pressed, sizeof(pressed));
+            if (count <= 0)
+                break; // stdin closed
+            for (ssize_t i = 0; i < count; ++i)
             {
-                vx /= len;
-                vy /= len;
-                p.wx += vx * patrolSpeed * dt;
-                p.wy += vy * patrolSpeed * dt;
+                if (pressed[i] == 'q')
+                    quit = true;
+                keys.press(pressed[i], seconds);
             }
-            p.stamina -= dt;
+            dirty = true;
         }
+        if (quit)
+            break;
 
-        float camX = cx - viewW / 2.0f;
-        float camY = cy - viewH / 2.0f;
+        MoveInput input = keys.held(seconds);
 
-        std::cout << "\033[H\033[J";
-        for (int y = 0; y < viewH; ++y)
+        // advance the simulation in fixed steps for the time that has passed
+        while (accumulator >= tickDt)
         {
-            for (int x = 0; x < viewW; ++x)
-            {
-                float wx = camX + x;
-                float wy = camY + y;
-                char c = getSymbol(noise.GetNoise(wx, wy));
-
-                bool printed = false;
-                for (auto &p : patrols)
-                {
-                    if (!p.active)
-                        continue;
-                    int px = (int)std::floor(p.wx);
-                    int py = (int)std::floor(p.wy);
-                    if (px == (int)std::floor(wx) && py == (int)std::floor(wy))
-                    {
-                        std::cout << 'P';
-                        printed = true;
-                        break;
-                    }
-                }
-
-                if (!printed)
-                {
-                    int px = (int)std::floor(cx);
-                    int py = (int)std::floor(cy);
-                    if (px == (int)std::floor(wx) && py == (int)std::floor(wy))
-                        std::cout << 'X';
-                    else
-                        std::cout << c;
-                }
-            }
-            std::cout << '\n';
+            sim.tick(tickDt, input);
+            accumulator -= tickDt;
         }
 
-        int activeCount = std::count_if(patrols.begin(), patrols.end(),
-                                        [](auto &p)
-                                        { return p.active; });
+        float dx, dy;
+        Simulation::direction(input, dx, dy);
+        prefetcher.update(sim.cx, sim.cy, dx, dy, Simulation::speedFor(input), ViewW, ViewH);
+
+        bool idle = sim.idle(input);
+        if (!idle || !wasIdle)
+            dirty = true;
+
+        if (dirty && renderTimer >= renderInterval)
+        {
+            renderTimer = std::fmod(renderTimer, renderInterval);
+            dirty = false;
+
+            // draw between the last two simulation states so motion stays smooth
+            // when ticks and frames do not line up
+            View view = viewAt(sim, accumulator / tickDt, ViewW, ViewH);
+
+            // terrain comes from cached chunks, noise only runs for chunks not seen recently
+            terrainCache.fillView(renderer.cells(), view.camX, view.camY, ViewW, ViewH);
+            stampEntities(renderer.cells(), ViewW, ViewH, sim, view);
 
-        std::cout << "Pos: (" << cx << ", " << cy << ")  "
-                  << "Active patrols: " << activeCount << "  "
-                  << "Run: " << (run ? "YES" : "no") << "\n";
+            setStatus(renderer, sim, input);
+            renderer.present();
+        }
 
-        usleep(16000); // ~60 FPS
+        // Tick while anything moves; when idle, sleep until the next spawn is due
+        // so an untouched session costs nothing between key presses
+        if (idle)
+        {
+            events.armOnce(std::max(sim.timeUntilSpawn() - accumulator, tickDt));
+            timerPeriodic = false;
+        }
+        else if (!timerPeriodic)
+        {
+            events.armPeriodic(std::min(tickDt, renderInterval));
+            timerPeriodic = true;
+        }
+        wasIdle = idle;
+
+        ready = events.wait();
     }
 
-    // unreachable
     setRawMode(false);
+    renderer.clearScreen();
+
+    universe.capture(sim);
+    if (!universe.save(universePath))
+    {
+        std::perror(universePath.c_str());
+        return 1;
+    }
     return 0;
 }
+
+int main(int argc, char **argv)
+{
+    Options options = parseOptions(argc, argv);
+    if (options.headless)
+        return runHeadless(options);
+    return runInteractive(options);
+}
@@ -0,0 +1,564 @@
+// Checks that the fast paths give what the simple ones they replace give, and that
+// saved worlds read back as written. Each check is one ctest case:
+//
+//   ExplorerTests grid
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "../ChunkStore.h"
+#include "../FastNoiseLite.h"
+#include "../Terrain.h"
+#include "../Universe.h"
+
+namespace
+{
+    const FastNoiseLite::SimdLevel SimdLevels[] = {FastNoiseLite::SimdLevel_Scalar, FastNoiseLite::SimdLevel_SSE41,
+                                                   FastNoiseLite::SimdLevel_AVX2};
+    const char *const SimdNames[] = {"Scalar", "SSE41", "AVX2"};
+    const char *const NoiseNames[] = {"OpenSimplex2", "OpenSimplex2S", "Cellular", "Perlin", "ValueCubic", "Value"};
+    const char *const FractalNames[] = {"None", "FBm", "Ridged", "PingPong", "DomainWarpProgressive", "DomainWarpIndependent"};
+    const char *const WarpNames[] = {"OpenSimplex2", "OpenSimplex2Reduced", "BasicGrid"};
+
+    // Counts results that differ in any bit from the expected ones, printing the first few
+    class Comparison
+    {
+    public:
+        explicit Comparison(const char *check)
+            : mCheck(check)
+        {
+        }
+
+        void expect(float actual, float expected, const std::string &setup, int index)
+        {
+            if (reportable(std::memcmp(&actual, &expected, sizeof(float)) == 0))
+                std::printf("%s: %s [%d] is %.9g, expected %.9g\n", mCheck, setup.c_str(), index, actual, expected);
+        }
+
+        void expect(char actual, char expected, const std::string &setup, int index)
+        {
+            if (reportable(actual == expected))
+                std::printf("%s: %s [%d] is '%c', expected '%c'\n", mCheck, setup.c_str(), index, actual, expected);
+        }
+
+        void expect(bool ok, const std::string &what)
+        {
+            if (reportable(ok))
+                std::printf("%s: %s failed\n", mCheck, what.c_str());
+        }
+
+        bool passed() const
+        {
+            std::printf("%s: %ld of %ld results differ\n", mCheck, mFailures, mTotal);
+            return mFailures == 0;
+        }
+
+    private:
+        static const long MaxReported = 10;
+
+        // counts a result, true for a difference among the first few
+        bool reportable(bool same)
+        {
+            ++mTotal;
+            return !same && mFailures++ < MaxReported;
+        }
+
+        const char *mCheck;
+        long mTotal = 0;
+        long mFailures = 0;
+    };
+
+    // A noise configuration and its name in failure reports
+    struct Setup
+    {
+        FastNoiseLite noise;
+        std::string name;
+    };
+
+    // Every noise and fractal type at every SIMD level; cellular also with each distance
+    // function, the return types with and without the 2x2 search and small and full jitter
+    std::vector<Setup> noiseSetups()
+    {
+        std::vector<Setup> setups;
+        for (int level = 0; level < 3; ++level)
+        {
+            for (int type = FastNoiseLite::NoiseType_OpenSimplex2; type <= FastNoiseLite::NoiseType_Value; ++type)
+            {
+                for (int fractal = FastNoiseLite::FractalType_None; fractal <= FastNoiseLite::FractalType_PingPong; ++fractal)
+                {
+                    Setup setup;
+                    setup.noise.SetSimdLevel(SimdLevels[level]);
+                    setup.noise.SetSeed(1337 + type);
+                    setup.noise.SetFrequency(0.037f);
+                    setup.noise.SetNoiseType((FastNoiseLite::NoiseType)type);
+                    setup.noise.SetFractalType((FastNoiseLite::FractalType)fractal);
+                    setup.name = std::string(SimdNames[level]) + " " + NoiseNames[type] + " " + FractalNames[fractal];
+                    if (type != FastNoiseLite::NoiseType_Cellular)
+                    {
+                        setups.push_back(setup);
+                        continue;
+                    }
+
+                    for (int distance = FastNoiseLite::CellularDistanceFunction_Euclidean;
+                         distance <= FastNoiseLite::CellularDistanceFunction_Hybrid; ++distance)
+                    {
+                        for (FastNoiseLite::CellularReturnType returnType :
+                             {FastNoiseLite::CellularReturnType_CellValue, FastNoiseLite::CellularReturnType_Distance,
+                              FastNoiseLite::CellularReturnType_Distance2Add})
+                        {
+                            for (float jitter : {1.0f, 0.3f})
+                            {
+                                Setup cellular = setup;
+                                cellular.noise.SetCellularDistanceFunction((FastNoiseLite::CellularDistanceFunction)distance);
+                                cellular.noise.SetCellularReturnType(returnType);
+                                cellular.noise.SetCellularJitter(jitter);
+                                cellular.name += " distance " + std::to_string(distance) + " return " +
+                                                 std::to_string((int)returnType) + " jitter " + std::to_string(jitter);
+                                setups.push_back(cellular);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        return setups;
+    }
+
+    // Every domain warp type, alone and with both fractal warps, at every SIMD level
+    std::vector<Setup> warpSetups()
+    {
+        std::vector<Setup> setups;
+        for (int level = 0; level < 3; ++level)
+        {
+            for (int type = FastNoiseLite::DomainWarpType_OpenSimplex2; type <= FastNoiseLite::DomainWarpType_BasicGrid; ++type)
+            {
+                for (FastNoiseLite::FractalType fractal : {FastNoiseLite::FractalType_None, FastNoiseLite::FractalType_DomainWarpProgressive,
+                                                           FastNoiseLite::FractalType_DomainWarpIndependent})
+                {
+                    Setup setup;
+                    setup.noise.SetSimdLevel(SimdLevels[level]);
+                    setup.noise.SetSeed(1337 + type);
+                    setup.noise.SetFrequency(0.02f);
+                    setup.noise.SetDomainWarpType((FastNoiseLite::DomainWarpType)type);
+                    setup.noise.SetDomainWarpAmp(30.0f);
+                    setup.noise.SetFractalType(fractal);
+                    setup.name = std::string(SimdNames[level]) + " " + WarpNames[type] + " " + FractalNames[fractal];
+                    setups.push_back(setup);
+                }
+            }
+        }
+        return setups;
+    }
+
+    // Positions spread over a few hundred cells, not a whole number of blocks
+    std::vector<float> positions(unsigned seed, int count)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> distribution(-500.0f, 500.0f);
+        std::vector<float> values(count);
+        for (float &value : values)
+            value = distribution(rng);
+        return values;
+    }
+
+    // GenGrid2D and GenGrid3D against GetNoise at each grid position
+    bool checkGrid()
+    {
+        const int width = 37, height = 23, depth = 5;
+        const int x0 = -40, y0 = 5, z0 = -3;
+        const float step = 0.7f;
+
+        Comparison comparison("grid");
+        std::vector<float> grid(width * height * depth);
+        for (Setup &setup : noiseSetups())
+        {
+            setup.noise.GenGrid2D(grid.data(), x0, y0, width, height, step);
+            for (int y = 0; y < height; ++y)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    int i = y * width + x;
+                    comparison.expect(grid[i], setup.noise.GetNoise(x0 + x * step, y0 + y * step), setup.name + " 2D", i);
+                }
+            }
+
+            for (int rotation = FastNoiseLite::RotationType3D_None; rotation <= FastNoiseLite::RotationType3D_ImproveXZPlanes; ++rotation)
+            {
+                setup.noise.SetRotationType3D((FastNoiseLite::RotationType3D)rotation);
+                std::string name = setup.name + " 3D rotation " + std::to_string(rotation);
+                setup.noise.GenGrid3D(grid.data(), x0, y0, z0, width, height, depth, step);
+                for (int z = 0; z < depth; ++z)
+                {
+                    for (int y = 0; y < height; ++y)
+                    {
+                        for (int x = 0; x < width; ++x)
+                        {
+                            int i = (z * height + y) * width + x;
+                            comparison.expect(grid[i], setup.noise.GetNoise(x0 + x * step, y0 + y * step, z0 + z * step), name, i);
+                        }
+                    }
+                }
+            }
+        }
+        return comparison.passed();
+    }
+
+    // The array GetNoise overloads against GetNoise one position at a time
+    bool checkArray()
+    {
+        const int count = 1000;
+        std::vector<float> xs = positions(1, count), ys = positions(2, count), zs = positions(3, count);
+
+        Comparison comparison("array");
+        std::vector<float> out(count);
+        for (Setup &setup : noiseSetups())
+        {
+            setup.noise.GetNoise(xs.data(), ys.data(), out.data(), count);
+            for (int i = 0; i < count; ++i)
+                comparison.expect(out[i], setup.noise.GetNoise(xs[i], ys[i]), setup.name + " 2D", i);
+
+            setup.noise.GetNoise(xs.data(), ys.data(), zs.data(), out.data(), count);
+            for (int i = 0; i < count; ++i)
+                comparison.expect(out[i], setup.noise.GetNoise(xs[i], ys[i], zs[i]), setup.name + " 3D", i);
+        }
+        return comparison.passed();
+    }
+
+    // The array DomainWarp overloads against DomainWarp one position at a time
+    bool checkWarp()
+    {
+        const int count = 1000;
+        const std::vector<float> xs = positions(1, count), ys = positions(2, count), zs = positions(3, count);
+
+        Comparison comparison("warp");
+        for (Setup &setup : warpSetups())
+        {
+            std::vector<float> wx = xs, wy = ys;
+            setup.noise.DomainWarp(wx.data(), wy.data(), count);
+            for (int i = 0; i < count; ++i)
+            {
+                float x = xs[i], y = ys[i];
+                setup.noise.DomainWarp(x, y);
+                comparison.expect(wx[i], x, setup.name + " 2D x", i);
+                comparison.expect(wy[i], y, setup.name + " 2D y", i);
+            }
+
+            for (int rotation = FastNoiseLite::RotationType3D_None; rotation <= FastNoiseLite::RotationType3D_ImproveXZPlanes; ++rotation)
+            {
+                setup.noise.SetRotationType3D((FastNoiseLite::RotationType3D)rotation);
+                std::string name = setup.name + " 3D rotation " + std::to_string(rotation);
+                wx = xs;
+                wy = ys;
+                std::vector<float> wz = zs;
+                setup.noise.DomainWarp(wx.data(), wy.data(), wz.data(), count);
+                for (int i = 0; i < count; ++i)
+                {
+                    float x = xs[i], y = ys[i], z = zs[i];
+                    setup.noise.DomainWarp(x, y, z);
+                    comparison.expect(wx[i], x, name + " x", i);
+                    comparison.expect(wy[i], y, name + " y", i);
+                    comparison.expect(wz[i], z, name + " z", i);
+                }
+            }
+        }
+        return comparison.passed();
+    }
+
+    // GenGridMulti2D and GenGridMulti3D against GetNoise with each field's seed; more
+    // fields than MaxFields, so the fields are also split across passes
+    bool checkMulti()
+    {
+        const int width = 21, height = 13, depth = 3;
+        const int x0 = 17, y0 = -9, z0 = 2;
+        const float step = 1.3f;
+        const int fields = 11;
+
+        Comparison comparison("multi");
+        int seeds[fields];
+        std::vector<std::vector<float>> grids(fields, std::vector<float>(width * height * depth));
+        float *out[fields];
+        for (int f = 0; f < fields; ++f)
+        {
+            seeds[f] = 1000 + 7919 * f;
+            out[f] = grids[f].data();
+        }
+
+        for (Setup &setup : noiseSetups())
+        {
+            setup.noise.GenGridMulti2D(out, seeds, fields, x0, y0, width, height, step);
+            for (int f = 0; f < fields; ++f)
+            {
+                setup.noise.SetSeed(seeds[f]);
+                std::string name = setup.name + " 2D field " + std::to_string(f);
+                for (int y = 0; y < height; ++y)
+                {
+                    for (int x = 0; x < width; ++x)
+                    {
+                        int i = y * width + x;
+                        comparison.expect(grids[f][i], setup.noise.GetNoise(x0 + x * step, y0 + y * step), name, i);
+                    }
+                }
+            }
+
+            setup.noise.GenGridMulti3D(out, seeds, fields, x0, y0, z0, width, height, depth, step);
+            for (int f = 0; f < fields; ++f)
+            {
+                setup.noise.SetSeed(seeds[f]);
+                std::string name = setup.name + " 3D field " + std::to_string(f);
+                for (int z = 0; z < depth; ++z)
+                {
+                    for (int y = 0; y < height; ++y)
+                    {
+                        for (int x = 0; x < width; ++x)
+                        {
+                            int i = (z * height + y) * width + x;
+                            comparison.expect(grids[f][i], setup.noise.GetNoise(x0 + x * step, y0 + y * step, z0 + z * step), name, i);
+                        }
+                    }
+                }
+            }
+        }
+        return comparison.passed();
+    }
+
+    // The symbol the bands give a value, the way getSymbol picked it before the table
+    char bandSymbol(const TerrainConfig &config, float v)
+    {
+        for (int band = 0; band < TerrainConfig::Bands - 1; ++band)
+        {
+            if (v < config.thresholds[band])
+                return config.symbols[band];
+        }
+        return config.symbols[TerrainConfig::Bands - 1];
+    }
+
+    // SymbolTable against the thresholds, for bands on step edges: the defaults and a
+    // spread of its own. Values are every float within 4096 of each threshold, a sweep
+    // past both ends of the noise range and a screen of Perlin noise.
+    bool checkSymbols()
+    {
+        const TerrainConfig spread = {{-0.5f, -0.25f, 0.25f, 0.5f}, {'~', '-', '=', '+', '^'}, {}};
+        const int count = 3000000;
+        const int width = 256, height = 256;
+
+        Comparison comparison("symbols");
+        for (const TerrainConfig &config : {TerrainConfig::defaults(), spread})
+        {
+            std::vector<float> values;
+            for (float threshold : config.thresholds)
+            {
+                float below = threshold, above = threshold;
+                values.push_back(threshold);
+                for (int i = 0; i < 4096; ++i)
+                {
+                    below = std::nextafter(below, -2.0f);
+                    above = std::nextafter(above, 2.0f);
+                    values.push_back(below);
+                    values.push_back(above);
+                }
+            }
+            for (int i = 0; i <= count; ++i)
+                values.push_back(-1.5f + 3.0f * i / count);
+            FastNoiseLite noise;
+            noise.SetNoiseType(FastNoiseLite::NoiseType_Perlin);
+            noise.SetFrequency(0.05f);
+            std::size_t first = values.size();
+            values.resize(first + width * height);
+            noise.GenGrid2D(values.data() + first, -width / 2, -height / 2, width, height);
+            // whole chunks, for pack and unpack
+            values.resize((values.size() + ChunkSize * ChunkSize - 1) / (ChunkSize * ChunkSize) * (ChunkSize * ChunkSize));
+
+            SymbolTable table(config);
+            std::string name = config.symbols[0] == '.' ? "defaults" : "spread";
+            std::vector<char> applied(values.size());
+            table.apply(values.data(), applied.data(), (int)values.size());
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                char expected = bandSymbol(config, values[i]);
+                comparison.expect(table.symbol(values[i]), expected, name + " symbol", (int)i);
+                comparison.expect(applied[i], expected, name + " apply", (int)i);
+            }
+
+            for (std::size_t start = 0; start < values.size(); start += ChunkSize * ChunkSize)
+            {
+                TerrainChunk chunk;
+                PackedChunk packed;
+                char symbols[ChunkSize * ChunkSize];
+                SymbolTable::quantize(values.data() + start, chunk.levels, ChunkSize * ChunkSize);
+                table.pack(chunk, packed);
+                table.unpack(packed, 0, ChunkSize * ChunkSize, symbols);
+                for (int i = 0; i < ChunkSize * ChunkSize; ++i)
+                    comparison.expect(symbols[i], bandSymbol(config, values[start + i]), name + " unpack", (int)(start + i));
+            }
+        }
+        return comparison.passed();
+    }
+
+    // Movement that keeps changing, so the player wanders and patrols chase
+    MoveInput scriptedInput(int tick)
+    {
+        MoveInput input = {};
+        input.right = tick % 300 < 200;
+        input.up = tick % 500 < 120;
+        input.left = tick % 1100 > 900;
+        input.run = tick % 7 == 0;
+        return input;
+    }
+
+    // Plays a simulation, saves it and loads it into a fresh one; both must then play on
+    // identically. A file cut short must not load.
+    bool checkUniverse()
+    {
+        const std::string path = "ExplorerTests.nxu";
+        const float dt = 1.0f / 60.0f;
+        const int ticks = 3000;
+
+        Comparison comparison("universe");
+        Universe saved(4242);
+        Simulation played(saved.simulationSeed());
+        int tick = 0;
+        for (; tick < ticks; ++tick)
+            played.tick(dt, scriptedInput(tick));
+        comparison.expect(played.patrols.size() > 0, "patrols to save");
+        saved.capture(played);
+
+        Universe loaded;
+        comparison.expect(saved.save(path) && loaded.load(path), "save and load " + path);
+        comparison.expect(std::memcmp(&loaded.header(), &saved.header(), sizeof(UniverseHeader)) == 0, "loaded header");
+
+        Universe truncated;
+        comparison.expect(truncate(path.c_str(), sizeof(UniverseHeader) + 4) == 0 && !truncated.load(path), "rejecting a cut short file");
+        std::remove(path.c_str());
+
+        Simulation resumed(loaded.simulationSeed());
+        loaded.restore(resumed);
+        for (; tick < 2 * ticks; ++tick)
+        {
+            played.tick(dt, scriptedInput(tick));
+            resumed.tick(dt, scriptedInput(tick));
+        }
+        comparison.expect(resumed.cx, played.cx, "player x", tick);
+        comparison.expect(resumed.cy, played.cy, "player y", tick);
+        comparison.expect(resumed.spawnTimer, played.spawnTimer, "spawn timer", tick);
+        comparison.expect(resumed.nextSpawnTime, played.nextSpawnTime, "next spawn", tick);
+        comparison.expect(resumed.rng == played.rng, "random engine state");
+        comparison.expect(resumed.patrols.size() == played.patrols.size(), "patrol count");
+        for (std::size_t i = 0; i < played.patrols.size() && i < resumed.patrols.size(); ++i)
+        {
+            comparison.expect(resumed.patrols.wx[i], played.patrols.wx[i], "patrol x", (int)i);
+            comparison.expect(resumed.patrols.wy[i], played.patrols.wy[i], "patrol y", (int)i);
+            comparison.expect(resumed.patrols.stamina[i], played.patrols.stamina[i], "patrol stamina", (int)i);
+        }
+        return comparison.passed();
+    }
+
+    // A chunk whose cells depend on its coordinates, so a slot read back for the wrong chunk shows
+    TerrainChunk patternChunk(int chunkX, int chunkY)
+    {
+        TerrainChunk chunk;
+        for (int i = 0; i < ChunkSize * ChunkSize; ++i)
+            chunk.levels[i] = (uint8_t)(i * 7 + chunkX * 31 + chunkY * 17);
+        return chunk;
+    }
+
+    bool storedChunk(const ChunkStore &store, int chunkX, int chunkY)
+    {
+        TerrainChunk chunk, expected = patternChunk(chunkX, chunkY);
+        return store.read(chunkX, chunkY, chunk) && std::memcmp(&chunk, &expected, sizeof(chunk)) == 0;
+    }
+
+    // Fills a chunk store past its first growth, damages one slot on disk and reopens it: the
+    // slots before the damage must survive and those from it on must be dropped for good
+    bool checkChunkStore()
+    {
+        const std::string path = "ExplorerTests.chunks";
+        const uint64_t fingerprint = 0x5eed;
+        const int chunks = 600;
+        const int damaged = 345;
+
+        Comparison comparison("chunkstore");
+        std::remove(path.c_str());
+        {
+            ChunkStore store;
+            comparison.expect(store.open(path, fingerprint), "creating " + path);
+            for (int i = 0; i < chunks; ++i)
+                store.write(i, -i, patternChunk(i, -i));
+        }
+        {
+            ChunkStore store;
+            comparison.expect(store.open(path, fingerprint) && store.size() == chunks, "reopening with every chunk");
+            for (int i = 0; i < chunks; ++i)
+                comparison.expect(storedChunk(store, i, -i), "reading chunk " + std::to_string(i));
+        }
+
+        // the header page starts with an 8-byte magic, the version and then the slot size;
+        // flipping a bit in the last cell of a slot leaves only its checksum to notice
+        int fd = open(path.c_str(), O_RDWR);
+        uint32_t slotBytes = 0;
+        bool damagedSlot = fd >= 0 && pread(fd, &slotBytes, sizeof(slotBytes), 12) == (ssize_t)sizeof(slotBytes);
+        off_t last = 4096 + (off_t)(damaged + 1) * slotBytes - 1;
+        char byte = 0;
+        damagedSlot = damagedSlot && pread(fd, &byte, 1, last) == 1;
+        byte ^= 0x40;
+        damagedSlot = damagedSlot && pwrite(fd, &byte, 1, last) == 1;
+        comparison.expect(damagedSlot, "damaging slot " + std::to_string(damaged));
+        if (fd >= 0)
+            close(fd);
+
+        {
+            ChunkStore store;
+            comparison.expect(store.open(path, fingerprint) && store.size() == damaged, "dropping the damaged slot and those after it");
+            for (int i = 0; i < chunks; ++i)
+                comparison.expect(storedChunk(store, i, -i) == (i < damaged), "chunk " + std::to_string(i) + " after the damage");
+            comparison.expect(store.write(chunks, 0, patternChunk(chunks, 0)), "appending after the damage");
+        }
+        {
+            ChunkStore store;
+            comparison.expect(store.open(path, fingerprint) && store.size() == damaged + 1, "reopening after the append");
+            comparison.expect(storedChunk(store, chunks, 0), "reading the appended chunk");
+            comparison.expect(!storedChunk(store, damaged + 1, -(damaged + 1)), "slots after the damage staying dropped");
+        }
+        {
+            ChunkStore store;
+            comparison.expect(store.open(path, fingerprint + 1) && store.size() == 0, "emptying for another fingerprint");
+        }
+        std::remove(path.c_str());
+        return comparison.passed();
+    }
+
+    struct Check
+    {
+        const char *name;
+        bool (*run)();
+    };
+
+    const Check Checks[] = {
+        {"grid", checkGrid},
+        {"array", checkArray},
+        {"warp", checkWarp},
+        {"multi", checkMulti},
+        {"symbols", checkSymbols},
+        {"universe", checkUniverse},
+        {"chunkstore", checkChunkStore},
+    };
+}
+
+int main(int argc, char **argv)
+{
+    for (const Check &check : Checks)
+    {
+        if (argc == 2 && std::strcmp(argv[1], check.name) == 0)
+            return check.run() ? 0 : 1;
+    }
+
+    std::fprintf(stderr, "usage: %s <check>, one of:", argv[0]);
+    for (const Check &check : Checks)
+        std::fprintf(stderr, " %s", check.name);
+    std::fputc('\n', stderr);
+    return 2;
+}